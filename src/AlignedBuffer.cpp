@@ -0,0 +1,67 @@
+#include "AlignedBuffer.h"
+#include <algorithm>
+#include <new>
+
+namespace heat {
+
+    AlignedBuffer::AlignedBuffer(std::size_t size) : data_(nullptr), size_(0) {
+        resize(size);
+    }
+
+    AlignedBuffer::AlignedBuffer(const AlignedBuffer& other) : data_(nullptr), size_(0) {
+        resize(other.size_);
+        std::copy(other.data_, other.data_ + other.size_, data_);
+    }
+
+    AlignedBuffer::AlignedBuffer(AlignedBuffer&& other) noexcept : data_(other.data_), size_(other.size_) {
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+
+    AlignedBuffer& AlignedBuffer::operator=(const AlignedBuffer& other) {
+        if (this != &other) {
+            resize(other.size_);
+            std::copy(other.data_, other.data_ + other.size_, data_);
+        }
+        return *this;
+    }
+
+    AlignedBuffer& AlignedBuffer::operator=(AlignedBuffer&& other) noexcept {
+        if (this != &other) {
+            release();
+            data_ = other.data_;
+            size_ = other.size_;
+            other.data_ = nullptr;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    AlignedBuffer::~AlignedBuffer() {
+        release();
+    }
+
+    void AlignedBuffer::release() {
+        if (data_) {
+            ::operator delete(data_, std::align_val_t(alignment));
+        }
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    void AlignedBuffer::resize(std::size_t size) {
+        if (size == size_) {
+            return; /** Reuse the existing block */
+        }
+        release();
+        if (size > 0) {
+            data_ = static_cast<double*>(::operator new(size * sizeof(double), std::align_val_t(alignment)));
+            size_ = size;
+        }
+    }
+
+    void AlignedBuffer::fill(double value) {
+        std::fill(data_, data_ + size_, value);
+    }
+
+}
@@ -0,0 +1,75 @@
+#ifndef ALIGNED_BUFFER_H
+#define ALIGNED_BUFFER_H
+
+#include <cstddef>
+
+namespace heat {
+
+    /**
+     * @brief Contiguous, 64-byte aligned array of doubles allocated in a single block.
+     *
+     * The buffer only reallocates when its size changes, so it can be resized on every
+     * solve without paying for a new allocation.
+     */
+    class AlignedBuffer {
+    private:
+        double* data_;     /**< Start of the aligned block */
+        std::size_t size_; /**< Number of doubles in the block */
+
+        /**
+         * @brief Releases the current block.
+         */
+        void release();
+
+    public:
+        static constexpr std::size_t alignment = 64; /**< Alignment of the block in bytes (one cache line) */
+
+        /**
+         * @brief Creates an empty buffer.
+         */
+        AlignedBuffer() : data_(nullptr), size_(0) {}
+
+        /**
+         * @brief Creates a buffer of a given size (values are uninitialized).
+         *
+         * @param size Number of doubles
+         */
+        explicit AlignedBuffer(std::size_t size);
+
+        AlignedBuffer(const AlignedBuffer& other);
+        AlignedBuffer(AlignedBuffer&& other) noexcept;
+        AlignedBuffer& operator=(const AlignedBuffer& other);
+        AlignedBuffer& operator=(AlignedBuffer&& other) noexcept;
+
+        /**
+         * @brief Releases the aligned block.
+         */
+        ~AlignedBuffer();
+
+        /**
+         * @brief Changes the size of the buffer, reallocating only if the size differs.
+         *
+         * The contents are unspecified after a reallocation.
+         *
+         * @param size Number of doubles
+         */
+        void resize(std::size_t size);
+
+        /**
+         * @brief Sets every value of the buffer.
+         *
+         * @param value Value to assign
+         */
+        void fill(double value);
+
+        double* data() { return data_; }
+        const double* data() const { return data_; }
+        std::size_t size() const { return size_; }
+
+        double& operator[](std::size_t i) { return data_[i]; }
+        const double& operator[](std::size_t i) const { return data_[i]; }
+    };
+
+}
+
+#endif
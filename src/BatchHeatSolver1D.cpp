@@ -0,0 +1,141 @@
+#include "BatchHeatSolver1D.h"
+#include <algorithm>
+#include <utility>
+
+namespace heat {
+
+    int BatchHeatSolver1D::addRod(const Material& material, double f) {
+        rods.push_back(Rod{material, f});
+        return static_cast<int>(rods.size()) - 1;
+    }
+
+    void BatchHeatSolver1D::setSnapshotSink(int stride, BatchSnapshotSink sink) {
+        snapshotStride = stride > 0 ? stride : 1;
+        snapshotSink = std::move(sink);
+    }
+
+    void BatchHeatSolver1D::solve() {
+        finalTemperatures.resize(rods.size() * static_cast<std::size_t>(rowStride));
+        finalTemperatures.fill(u0);
+
+        /** Workspace shared by every group, allocated once per batch size */
+        std::size_t laneSize = static_cast<std::size_t>(N) * lanes;
+        laneTemperature.resize(laneSize);
+        laneSource.resize(laneSize);
+        laneCStar.resize(laneSize);
+        laneInvPivot.resize(laneSize);
+
+        for (int first = 0; first < rodCount(); first += lanes) {
+            solveGroup(first, std::min(lanes, rodCount() - first));
+        }
+    }
+
+    void BatchHeatSolver1D::solveGroup(int firstRod, int count) {
+        double* __restrict u = laneTemperature.data();
+        double* __restrict s = laneSource.data();
+        double* __restrict cStar = laneCStar.data();
+        double* __restrict m = laneInvPivot.data();
+        double a[lanes];          /** Sub-diagonal (-r) of each lane */
+        double firstPivot[lanes]; /** Main diagonal of the first row of each lane */
+
+        /** Per-lane coefficients; unused lanes repeat the last rod of the group */
+        for (int l = 0; l < lanes; ++l) {
+            const Rod& rod = rods[firstRod + std::min(l, count - 1)];
+            const Material& material = rod.material;
+            Heatsource1D source(tmax, L, rod.f);
+
+            double alpha = material.conductivity / (material.density * material.specificHeat);
+            double r = alpha * dt / (dx * dx);
+            double b = 1 + 2 * r;
+            a[l] = -r;
+            firstPivot[l] = b;
+
+            /** Factor the lane matrix (same recurrence as TridiagonalOperator) */
+            double previousCStar = -r / b;
+            cStar[l] = previousCStar;
+            for (int i = 1; i < N; ++i) {
+                double pivot = 1.0 / (b - a[l] * previousCStar);
+                m[i * lanes + l] = pivot;
+                previousCStar = -r * pivot;
+                cStar[i * lanes + l] = previousCStar;
+            }
+
+            for (int x = 0; x < N; ++x) {
+                s[x * lanes + l] = dt * source.F(x * dx) / (material.density * material.specificHeat);
+                u[x * lanes + l] = u0;
+            }
+        }
+
+        std::vector<double> snapshot(snapshotSink ? N : 0);
+        auto emitSnapshots = [&](int timeStep) {
+            if (!snapshotSink || (timeStep % snapshotStride != 0 && timeStep != M - 1)) {
+                return;
+            }
+            for (int l = 0; l < count; ++l) {
+                for (int x = 0; x < N; ++x) {
+                    snapshot[x] = u[x * lanes + l];
+                }
+                snapshotSink(firstRod + l, timeStep, snapshot.data(), N);
+            }
+        };
+        emitSnapshots(0);
+
+        /** Time-stepping loop: every statement below runs across all lanes at once */
+        for (int n = 0; n < M - 1; ++n) {
+            /** Right-hand side, built in place: Neumann row keeps u[0], Dirichlet row is u0 */
+            for (int x = 1; x < N - 1; ++x) {
+                for (int l = 0; l < lanes; ++l) {
+                    u[x * lanes + l] = u[x * lanes + l] + s[x * lanes + l];
+                }
+            }
+            for (int l = 0; l < lanes; ++l) {
+                u[(N - 1) * lanes + l] = u0;
+            }
+
+            /** Forward substitution */
+            for (int l = 0; l < lanes; ++l) {
+                u[l] = u[l] / firstPivot[l];
+            }
+            for (int i = 1; i < N; ++i) {
+                for (int l = 0; l < lanes; ++l) {
+                    u[i * lanes + l] = (u[i * lanes + l] - a[l] * u[(i - 1) * lanes + l]) * m[i * lanes + l];
+                }
+            }
+
+            /** Back substitution */
+            for (int i = N - 2; i >= 0; --i) {
+                for (int l = 0; l < lanes; ++l) {
+                    u[i * lanes + l] = u[i * lanes + l] - cStar[i * lanes + l] * u[(i + 1) * lanes + l];
+                }
+            }
+
+            /** Boundary conditions (Neumann at x = 0, Dirichlet at x = L) */
+            for (int l = 0; l < lanes; ++l) {
+                u[l] = u[lanes + l];
+                u[(N - 1) * lanes + l] = u0;
+            }
+
+            emitSnapshots(n + 1);
+        }
+
+        /** De-interleave the final profiles */
+        for (int l = 0; l < count; ++l) {
+            double* row = finalTemperatures.data() + static_cast<std::size_t>(firstRod + l) * rowStride;
+            for (int x = 0; x < N; ++x) {
+                row[x] = u[x * lanes + l];
+            }
+        }
+    }
+
+    const double* BatchHeatSolver1D::getFinalTemperature(int rod) const {
+        if (rod < 0 || rod >= rodCount() || finalTemperatures.size() == 0) {
+            return nullptr;
+        }
+        return finalTemperatures.data() + static_cast<std::size_t>(rod) * rowStride;
+    }
+
+    FieldView BatchHeatSolver1D::getFinalTemperatures() const {
+        return FieldView(finalTemperatures.data(), rodCount(), N, rowStride);
+    }
+
+}
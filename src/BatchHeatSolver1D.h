@@ -0,0 +1,130 @@
+#ifndef BATCH_HEAT_SOLVER_1D_H
+#define BATCH_HEAT_SOLVER_1D_H
+
+#include <functional>
+#include <vector>
+#include "AlignedBuffer.h"
+#include "FieldView.h"
+#include "Material.h"
+#include "Heatsource1D.h"
+
+/**
+ * @brief Solves the one-dimensional heat equation for many independent rods at once.
+ */
+namespace heat {
+
+    /**
+     * @brief Callback receiving a snapshot of one rod of a batch.
+     *
+     * @param rod Index of the rod (order of addRod calls)
+     * @param timeStep The time step index of the snapshot
+     * @param temperature Pointer to the temperature profile (valid only during the call)
+     * @param size Number of values in the profile
+     */
+    using BatchSnapshotSink = std::function<void(int rod, int timeStep, const double* temperature, int size)>;
+
+    /**
+     * @brief Batched implicit solver for rods sharing the same grid but not the same material or source.
+     *
+     * Rods are processed in groups of `lanes` systems stored in structure-of-arrays layout
+     * (value x of lane l at index x * lanes + l). The Thomas recurrence then runs along x
+     * with the innermost loop over the lanes, which the compiler maps onto AVX2/AVX-512
+     * registers. Each rod gets exactly the same result as HeatEquationSolver1D.
+     */
+    class BatchHeatSolver1D {
+    public:
+        static constexpr int lanes = 8; /**< Rods advanced together (8 doubles = one AVX-512 register) */
+
+    private:
+        /**
+         * @brief Parameters of one rod of the batch.
+         */
+        struct Rod {
+            Material material; /**< Material of the rod */
+            double f;          /**< Heat source intensity factor */
+        };
+
+        double L;     /**< Length of the domain */
+        double tmax;  /**< Maximum simulation time */
+        double u0;    /**< Initial temperature */
+        int N;        /**< Number of spatial divisions */
+        int M;        /**< Number of time steps */
+        double dx;    /**< Spatial step size */
+        double dt;    /**< Time step size */
+        int rowStride; /**< Distance between two result rows (N padded to a cache line) */
+
+        std::vector<Rod> rods;            /**< Rods to solve */
+        AlignedBuffer finalTemperatures;  /**< Final profile of every rod, one padded row per rod */
+        int snapshotStride;               /**< Emit a snapshot every snapshotStride steps */
+        BatchSnapshotSink snapshotSink;   /**< Receiver of the snapshots (may be empty) */
+
+        AlignedBuffer laneTemperature;    /**< Interleaved temperatures of the current group (N x lanes) */
+        AlignedBuffer laneSource;         /**< Interleaved cached source terms (N x lanes) */
+        AlignedBuffer laneCStar;          /**< Interleaved modified super-diagonals (N x lanes) */
+        AlignedBuffer laneInvPivot;       /**< Interleaved reciprocal pivots (N x lanes) */
+
+        /**
+         * @brief Advances one group of up to `lanes` rods through all time steps.
+         *
+         * @param firstRod Index of the first rod of the group
+         * @param count Number of rods in the group (1 to lanes)
+         */
+        void solveGroup(int firstRod, int count);
+
+    public:
+        /**
+         * @brief Constructor to initialize the batch grid
+         *
+         * @param L Length of the domain.
+         * @param tmax Maximum simulation time.
+         * @param u0 Initial temperature.
+         * @param N Number of spatial divisions.
+         * @param M Number of time steps.
+         */
+        BatchHeatSolver1D(double L, double tmax, double u0, int N, int M)
+            : L(L), tmax(tmax), u0(u0), N(N), M(M), dx(L / (N - 1)), dt(tmax / (M - 1)),
+              rowStride((N + 7) & ~7), snapshotStride(1) {}
+
+        /**
+         * @brief Adds a rod to the batch
+         *
+         * @param material Material of the rod
+         * @param f Heat source intensity factor of the rod
+         * @return Index of the rod in the batch
+         */
+        int addRod(const Material& material, double f);
+
+        /**
+         * @brief Number of rods in the batch
+         */
+        int rodCount() const { return static_cast<int>(rods.size()); }
+
+        /**
+         * @brief Sends every stride-th time step (and the last one) of every rod to a sink
+         *
+         * @param stride Snapshot interval in time steps (>= 1)
+         * @param sink Receiver of the snapshots (may be empty)
+         */
+        void setSnapshotSink(int stride, BatchSnapshotSink sink);
+
+        /**
+         * @brief Advances every rod of the batch through all time steps
+         */
+        void solve();
+
+        /**
+         * @brief Gets the temperature profile of a rod at the last time step
+         *
+         * @param rod Index of the rod
+         * @return A pointer to the final temperature profile, or nullptr if the rod does not exist
+         */
+        const double* getFinalTemperature(int rod) const;
+
+        /**
+         * @brief Gets a view of the final profiles of all rods (one row per rod)
+         */
+        FieldView getFinalTemperatures() const;
+    };
+}
+
+#endif
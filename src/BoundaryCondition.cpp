@@ -0,0 +1,24 @@
+#include "BoundaryCondition.h"
+#include <vector>
+
+namespace heat {
+
+    void factorLineOperator(TridiagonalOperator& op, double r, int size, const BoundaryCondition& low, const BoundaryCondition& high) {
+        std::vector<double> a(size - 1, -r), b(size, 1 + 2 * r), c(size - 1, -r);
+
+        /** First row: u_0 = g, or u_0 - u_1 = du/dn * dx (outward normal points to -x) */
+        b[0] = 1.0;
+        c[0] = low.type == BoundaryCondition::Type::Dirichlet ? 0.0 : -1.0;
+
+        /** Last row: u_{N-1} = g, or u_{N-1} - u_{N-2} = du/dn * dx */
+        b[size - 1] = 1.0;
+        a[size - 2] = high.type == BoundaryCondition::Type::Dirichlet ? 0.0 : -1.0;
+
+        op.factor(a.data(), b.data(), c.data(), size);
+    }
+
+    double boundaryRhs(const BoundaryCondition& bc, double dx) {
+        return bc.type == BoundaryCondition::Type::Dirichlet ? bc.value : bc.value * dx;
+    }
+
+}
@@ -0,0 +1,74 @@
+#ifndef BOUNDARY_CONDITION_H
+#define BOUNDARY_CONDITION_H
+
+#include "TridiagonalOperator.h"
+
+namespace heat {
+
+    /**
+     * @brief Condition imposed on one edge of the domain.
+     */
+    struct BoundaryCondition {
+        /**
+         * @brief Kind of boundary condition.
+         */
+        enum class Type {
+            Dirichlet, /**< Fixed temperature u = value */
+            Neumann    /**< Fixed outward normal derivative du/dn = value (0 = insulated) */
+        };
+
+        Type type;    /** Kind of condition */
+        double value; /** Imposed temperature (Dirichlet) or outward normal derivative (Neumann) */
+
+        /**
+         * @brief Fixed temperature on the edge.
+         *
+         * @param temperature : Temperature of the edge
+         */
+        static BoundaryCondition dirichlet(double temperature) { return BoundaryCondition{Type::Dirichlet, temperature}; }
+
+        /**
+         * @brief Fixed outward normal derivative on the edge.
+         *
+         * @param gradient : Outward normal derivative du/dn (default 0, insulated edge)
+         */
+        static BoundaryCondition neumann(double gradient = 0.0) { return BoundaryCondition{Type::Neumann, gradient}; }
+    };
+
+    /**
+     * @brief Conditions on the four edges of a square plate.
+     */
+    struct BoundaryConditions2D {
+        BoundaryCondition left;   /** Edge x = 0 */
+        BoundaryCondition right;  /** Edge x = L */
+        BoundaryCondition bottom; /** Edge y = 0 */
+        BoundaryCondition top;    /** Edge y = L */
+    };
+
+    /**
+     * @brief Factors the implicit operator of one grid line with its end conditions folded in.
+     *
+     * Interior rows are (-r, 1 + 2r, -r). A Dirichlet end becomes the row u = d, a Neumann
+     * end the first-order row u_end - u_inner = d. The matching right-hand side values are
+     * given by boundaryRhs().
+     *
+     * @param op : Operator to factor
+     * @param r : alpha * dt / dx^2
+     * @param size : Number of points on the line
+     * @param low : Condition at the first point of the line
+     * @param high : Condition at the last point of the line
+     */
+    void factorLineOperator(TridiagonalOperator& op, double r, int size, const BoundaryCondition& low, const BoundaryCondition& high);
+
+    /**
+     * @brief Right-hand side of a boundary row built by factorLineOperator().
+     *
+     * @param bc : Condition of the edge
+     * @param dx : Spatial step size
+     * @return The imposed temperature (Dirichlet) or du/dn * dx (Neumann)
+     */
+    double boundaryRhs(const BoundaryCondition& bc, double dx);
+
+}
+
+#endif
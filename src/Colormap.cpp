@@ -0,0 +1,110 @@
+#include "Colormap.h"
+#include "Metrics.h"
+#include "Tracer.h"
+
+namespace heat {
+
+    namespace {
+
+        /**
+         * @brief Color stop of a piecewise linear scale (components in [0, 1]).
+         */
+        struct ColorStop {
+            double r, g, b;
+        };
+
+        const ColorStop viridisStops[] = {
+            {0.267, 0.005, 0.329}, {0.283, 0.141, 0.458}, {0.254, 0.265, 0.530},
+            {0.207, 0.372, 0.553}, {0.164, 0.471, 0.558}, {0.128, 0.567, 0.551},
+            {0.135, 0.659, 0.518}, {0.267, 0.749, 0.441}, {0.478, 0.821, 0.318},
+            {0.741, 0.873, 0.150}, {0.993, 0.906, 0.144}
+        };
+
+        const ColorStop infernoStops[] = {
+            {0.001, 0.000, 0.014}, {0.087, 0.045, 0.225}, {0.258, 0.039, 0.406},
+            {0.416, 0.090, 0.433}, {0.578, 0.148, 0.404}, {0.735, 0.216, 0.330},
+            {0.865, 0.317, 0.226}, {0.955, 0.470, 0.098}, {0.988, 0.645, 0.040},
+            {0.964, 0.843, 0.273}, {0.988, 0.998, 0.645}
+        };
+
+        std::uint32_t pack(double r, double g, double b) {
+            auto channel = [](double v) { return static_cast<std::uint32_t>(static_cast<std::uint8_t>(v)); };
+            return 0xFF000000u | (channel(r) << 16) | (channel(g) << 8) | channel(b);
+        }
+
+        std::uint32_t interpolate(const ColorStop* stops, int count, double n) {
+            double x = n * (count - 1);
+            int k = static_cast<int>(x);
+            if (k >= count - 1) k = count - 2;
+            double w = x - k;
+            const ColorStop& lo = stops[k];
+            const ColorStop& hi = stops[k + 1];
+            return pack(255.0 * (lo.r + w * (hi.r - lo.r)) + 0.5,
+                        255.0 * (lo.g + w * (hi.g - lo.g)) + 0.5,
+                        255.0 * (lo.b + w * (hi.b - lo.b)) + 0.5);
+        }
+
+        /** Branch-free normalize, clamp and lookup of one contiguous run */
+        void lookup(const std::uint32_t* __restrict table, const double* __restrict in, int count,
+                    double minValue, double maxValue, std::uint32_t* __restrict dst) {
+            const int tableSize = Colormap::tableSize;
+            double range = maxValue - minValue;
+            double scale = range > 0.0 ? (tableSize - 1) / range : 0.0;
+            const double top = tableSize - 1;
+            for (int i = 0; i < count; ++i) {
+                double x = (in[i] - minValue) * scale;
+                x = x < top ? x : top;
+                x = x > 0.0 ? x : 0.0;
+                dst[i] = table[static_cast<int>(x)];
+            }
+        }
+
+    }
+
+    Colormap::Colormap(ColormapKind kind) : kind_(kind), table_(tableSize) {
+        for (int k = 0; k < tableSize; ++k) {
+            double n = static_cast<double>(k) / (tableSize - 1);
+            switch (kind) {
+                case ColormapKind::GreenRed:
+                    table_[k] = pack(n * 255, (1.0 - n) * 255, 0.0);
+                    break;
+                case ColormapKind::BlueRed: {
+                    double red = static_cast<std::uint8_t>(n * 255);
+                    table_[k] = pack(red, 0.0, 255 - red);
+                    break;
+                }
+                case ColormapKind::Viridis:
+                    table_[k] = interpolate(viridisStops, sizeof(viridisStops) / sizeof(viridisStops[0]), n);
+                    break;
+                case ColormapKind::Inferno:
+                    table_[k] = interpolate(infernoStops, sizeof(infernoStops) / sizeof(infernoStops[0]), n);
+                    break;
+                case ColormapKind::Grayscale:
+                    table_[k] = pack(n * 255, n * 255, n * 255);
+                    break;
+            }
+        }
+    }
+
+    std::uint32_t Colormap::color(double normalized) const {
+        double x = normalized * (tableSize - 1);
+        x = x < tableSize - 1 ? x : tableSize - 1; /** NaN goes to the hottest color */
+        x = x > 0.0 ? x : 0.0;
+        return table_[static_cast<int>(x)];
+    }
+
+    void Colormap::colorize(const double* values, int count, double minValue, double maxValue, std::uint32_t* out) const {
+        HEAT_TRACE_SCOPE("colorize");
+        HEAT_METRIC_SCOPE(MetricPhase::Colorize, (sizeof(double) + sizeof(std::uint32_t)) * count);
+        lookup(table_.data(), values, count, minValue, maxValue, out);
+    }
+
+    void Colormap::colorize(const FieldView& field, double minValue, double maxValue, std::uint32_t* out) const {
+        HEAT_TRACE_SCOPE("colorize");
+        HEAT_METRIC_SCOPE(MetricPhase::Colorize, (sizeof(double) + sizeof(std::uint32_t)) * field.rows() * field.cols());
+        for (int i = 0; i < field.rows(); ++i) {
+            lookup(table_.data(), field.row(i), field.cols(), minValue, maxValue, out + static_cast<std::size_t>(i) * field.cols());
+        }
+    }
+
+}
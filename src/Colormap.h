@@ -0,0 +1,78 @@
+#ifndef COLORMAP_H
+#define COLORMAP_H
+
+#include <cstdint>
+#include <vector>
+#include "FieldView.h"
+
+namespace heat {
+
+    /**
+     * @brief Available temperature color scales.
+     */
+    enum class ColormapKind {
+        GreenRed,  /**< Green (cold) to red (hot), the 1D profile scale */
+        BlueRed,   /**< Blue (cold) to red (hot), the 2D plate scale */
+        Viridis,   /**< Perceptually uniform dark blue - green - yellow */
+        Inferno,   /**< Perceptually uniform black - purple - orange - pale yellow */
+        Grayscale  /**< Black (cold) to white (hot) */
+    };
+
+    /**
+     * @brief Temperature-to-color conversion through a precomputed lookup table.
+     *
+     * Colors are packed ARGB8888 values (0xAARRGGBB), the pixel format of StreamingTexture.
+     * colorize() converts a whole frame with one normalize-clamp-lookup per value; the loop
+     * has no branches so the compiler vectorizes it (gathers on AVX2/AVX-512).
+     */
+    class Colormap {
+    public:
+        static constexpr int tableSize = 4096; /**< Number of entries of the lookup table */
+
+    private:
+        ColormapKind kind_;               /**< Scale stored in the table */
+        std::vector<std::uint32_t> table_; /**< Packed colors for normalized values 0 to 1 */
+
+    public:
+        /**
+         * @brief Builds the lookup table of a color scale.
+         *
+         * @param kind Color scale
+         */
+        explicit Colormap(ColormapKind kind = ColormapKind::GreenRed);
+
+        /**
+         * @brief Color scale of this map.
+         */
+        ColormapKind kind() const { return kind_; }
+
+        /**
+         * @brief Color of a normalized value (clamped to [0, 1]).
+         */
+        std::uint32_t color(double normalized) const;
+
+        /**
+         * @brief Converts an array of values to packed colors.
+         *
+         * @param values Input values
+         * @param count Number of values
+         * @param minValue Value mapped to the first color
+         * @param maxValue Value mapped to the last color
+         * @param out Output colors (count entries)
+         */
+        void colorize(const double* values, int count, double minValue, double maxValue, std::uint32_t* out) const;
+
+        /**
+         * @brief Converts a field to packed colors, row i column j going to out[i * cols + j].
+         *
+         * @param field Input field
+         * @param minValue Value mapped to the first color
+         * @param maxValue Value mapped to the last color
+         * @param out Output colors (rows * cols entries)
+         */
+        void colorize(const FieldView& field, double minValue, double maxValue, std::uint32_t* out) const;
+    };
+
+}
+
+#endif
@@ -0,0 +1,60 @@
+#include "DisplaySession.h"
+#include "Metrics.h"
+#include "Tracer.h"
+#include <stdexcept>
+#include <string>
+
+namespace heat {
+
+    DisplaySession::DisplaySession(const char* title, int width, int height)
+        : window_(nullptr), renderer_(nullptr), width_(width), height_(height) {
+        if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+            throw std::runtime_error(std::string("SDL_Init Error: ") + SDL_GetError());
+        }
+        window_ = SDL_CreateWindow(title, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, width, height, SDL_WINDOW_SHOWN);
+        if (!window_) {
+            std::string error = std::string("SDL_CreateWindow Error: ") + SDL_GetError();
+            SDL_Quit();
+            throw std::runtime_error(error);
+        }
+        renderer_ = SDL_CreateRenderer(window_, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+        if (!renderer_) {
+            std::string error = std::string("SDL_CreateRenderer Error: ") + SDL_GetError();
+            SDL_DestroyWindow(window_);
+            SDL_Quit();
+            throw std::runtime_error(error);
+        }
+    }
+
+    DisplaySession::~DisplaySession() {
+        for (StreamingTexture& texture : textures_) {
+            texture.release(); /** Textures belong to the renderer: destroy them first */
+        }
+        SDL_DestroyRenderer(renderer_);
+        SDL_DestroyWindow(window_);
+        SDL_Quit();
+    }
+
+    void DisplaySession::beginScene(const char* title, int width, int height) {
+        SDL_SetWindowTitle(window_, title);
+        if (width != width_ || height != height_) {
+            SDL_SetWindowSize(window_, width, height);
+            width_ = width;
+            height_ = height;
+        }
+
+        // Start from a black window and drop keys and clicks meant for the previous scene; a quit
+        // request (window closed between two scenes) stays queued so that the new scene sees it
+        SDL_SetRenderDrawColor(renderer_, 0, 0, 0, 255);
+        SDL_RenderClear(renderer_);
+        present();
+        SDL_FlushEvents(SDL_KEYDOWN, SDL_MOUSEWHEEL);
+    }
+
+    void DisplaySession::present() {
+        HEAT_TRACE_SCOPE("present");
+        HEAT_METRIC_SCOPE(MetricPhase::Present, 0);
+        SDL_RenderPresent(renderer_);
+    }
+
+}
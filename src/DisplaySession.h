@@ -0,0 +1,80 @@
+#ifndef DISPLAY_SESSION_H
+#define DISPLAY_SESSION_H
+
+#include <SDL2/SDL.h>
+#include "StreamingTexture.h"
+
+namespace heat {
+
+    /**
+     * @brief Textures kept by a display session, one per kind of picture.
+     */
+    enum class SceneTexture {
+        Frame,     /**< 2D temperature frames */
+        Map,       /**< 1D temperature maps (one row per time step) */
+        Kymograph  /**< 1D space-time heatmap */
+    };
+
+    /**
+     * @brief Long-lived SDL state shared by every visualization of a program run.
+     *
+     * Initializes SDL once and owns the window, the renderer and the streaming textures.
+     * Each run starts a scene, which retitles and resizes the same window, so runs follow
+     * each other without re-initializing SDL; textures are only recreated when a run needs
+     * a different size.
+     */
+    class DisplaySession {
+    private:
+        SDL_Window* window_;     /**< The window shared by every scene */
+        SDL_Renderer* renderer_; /**< Renderer of the window */
+        int width_;              /**< Current window width */
+        int height_;             /**< Current window height */
+        StreamingTexture textures_[3]; /**< One texture per SceneTexture */
+
+    public:
+        /**
+         * @brief Initializes SDL and opens the window.
+         *
+         * @param title Initial window title
+         * @param width Initial window width
+         * @param height Initial window height
+         * @throws std::runtime_error if SDL, the window or the renderer cannot be created
+         */
+        DisplaySession(const char* title, int width, int height);
+
+        /**
+         * @brief Destroys the textures, the renderer and the window, then shuts SDL down.
+         */
+        ~DisplaySession();
+
+        DisplaySession(const DisplaySession&) = delete;
+        DisplaySession& operator=(const DisplaySession&) = delete;
+
+        /**
+         * @brief Starts a new scene in the same window.
+         *
+         * @param title Window title of the scene
+         * @param width Window width of the scene (resizes the window if it differs)
+         * @param height Window height of the scene
+         */
+        void beginScene(const char* title, int width, int height);
+
+        /**
+         * @brief Shows the frame drawn so far (SDL_RenderPresent, waits for vsync).
+         */
+        void present();
+
+        SDL_Window* window() const { return window_; }
+        SDL_Renderer* renderer() const { return renderer_; }
+        int width() const { return width_; }
+        int height() const { return height_; }
+
+        /**
+         * @brief Returns one of the session textures.
+         */
+        StreamingTexture& texture(SceneTexture kind) { return textures_[static_cast<int>(kind)]; }
+    };
+
+}
+
+#endif
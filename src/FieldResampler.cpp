@@ -0,0 +1,72 @@
+#include "FieldResampler.h"
+#include <algorithm>
+
+namespace heat {
+
+    FieldView FieldResampler::resample(const FieldView& source, int rows, int cols, ResampleMode mode) {
+        const int sourceRows = source.rows();
+        const int sourceCols = source.cols();
+        rows_ = std::max(1, std::min(rows, sourceRows));
+        cols_ = std::max(1, std::min(cols, sourceCols));
+        rowStride_ = (cols_ + 7) & ~7;
+        if (source.empty()) {
+            rows_ = cols_ = rowStride_ = 0;
+            return result();
+        }
+        values_.resize(static_cast<std::size_t>(rows_) * rowStride_);
+        runningRow_.resize(sourceCols);
+
+        columnStart_.resize(cols_ + 1);
+        for (int j = 0; j <= cols_; ++j) {
+            columnStart_[j] = static_cast<int>(static_cast<long long>(j) * sourceCols / cols_);
+        }
+
+        for (int i = 0; i < rows_; ++i) {
+            const int r0 = static_cast<int>(static_cast<long long>(i) * sourceRows / rows_);
+            const int r1 = static_cast<int>(static_cast<long long>(i + 1) * sourceRows / rows_);
+            double* running = runningRow_.data();
+
+            // Fold the covered source rows into one row (contiguous loops, vectorized)
+            const double* first = source.row(r0);
+            std::copy(first, first + sourceCols, running);
+            for (int r = r0 + 1; r < r1; ++r) {
+                const double* row = source.row(r);
+                switch (mode) {
+                case ResampleMode::Box:
+                    for (int c = 0; c < sourceCols; ++c) running[c] += row[c];
+                    break;
+                case ResampleMode::Max:
+                    for (int c = 0; c < sourceCols; ++c) running[c] = std::max(running[c], row[c]);
+                    break;
+                case ResampleMode::Min:
+                    for (int c = 0; c < sourceCols; ++c) running[c] = std::min(running[c], row[c]);
+                    break;
+                }
+            }
+
+            // Reduce the column bins of the folded row
+            double* out = values_.data() + static_cast<std::size_t>(i) * rowStride_;
+            const double rowsCovered = r1 - r0;
+            for (int j = 0; j < cols_; ++j) {
+                const int c0 = columnStart_[j];
+                const int c1 = columnStart_[j + 1];
+                double value = running[c0];
+                switch (mode) {
+                case ResampleMode::Box:
+                    for (int c = c0 + 1; c < c1; ++c) value += running[c];
+                    value /= rowsCovered * (c1 - c0);
+                    break;
+                case ResampleMode::Max:
+                    for (int c = c0 + 1; c < c1; ++c) value = std::max(value, running[c]);
+                    break;
+                case ResampleMode::Min:
+                    for (int c = c0 + 1; c < c1; ++c) value = std::min(value, running[c]);
+                    break;
+                }
+                out[j] = value;
+            }
+        }
+        return result();
+    }
+
+}
@@ -0,0 +1,61 @@
+#ifndef FIELD_RESAMPLER_H
+#define FIELD_RESAMPLER_H
+
+#include <vector>
+#include "AlignedBuffer.h"
+#include "FieldView.h"
+
+namespace heat {
+
+    /**
+     * @brief How the source cells covered by one output cell are combined.
+     */
+    enum class ResampleMode {
+        Box, /**< Mean of the covered cells (smooth, hides single-cell peaks) */
+        Max, /**< Hottest covered cell (keeps hot spots visible) */
+        Min  /**< Coldest covered cell */
+    };
+
+    /**
+     * @brief Reduces a 2D field to a smaller resolution.
+     *
+     * Output cell (i, j) covers source rows [i*R/r, (i+1)*R/r) and columns [j*C/c, (j+1)*C/c),
+     * so every source cell belongs to exactly one output cell. Source rows are folded into
+     * a running row first and the columns are reduced afterwards, which reads the source
+     * once in memory order. The result is stored in a buffer reused between calls.
+     */
+    class FieldResampler {
+    private:
+        int rows_;                    /**< Rows of the last result */
+        int cols_;                    /**< Columns of the last result */
+        int rowStride_;               /**< cols_ padded to a cache line */
+        AlignedBuffer values_;        /**< Last result */
+        std::vector<double> runningRow_; /**< Source rows of one output row, combined */
+        std::vector<int> columnStart_;   /**< First source column of each output column (plus end) */
+
+    public:
+        FieldResampler() : rows_(0), cols_(0), rowStride_(0) {}
+
+        /**
+         * @brief Resamples a field.
+         *
+         * The target size is clamped to the source size: fields are never upsampled here
+         * (the renderer scales small textures up for free).
+         *
+         * @param source Field to reduce
+         * @param rows Target number of rows
+         * @param cols Target number of columns
+         * @param mode How covered cells are combined
+         * @return View of the result, valid until the next call
+         */
+        FieldView resample(const FieldView& source, int rows, int cols, ResampleMode mode);
+
+        /**
+         * @brief View of the last result.
+         */
+        FieldView result() const { return FieldView(values_.data(), rows_, cols_, rowStride_); }
+    };
+
+}
+
+#endif
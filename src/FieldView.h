@@ -0,0 +1,113 @@
+#ifndef FIELD_VIEW_H
+#define FIELD_VIEW_H
+
+#include <cstddef>
+
+namespace heat {
+
+    /**
+     * @brief Non-owning, read-only view of a row-major 2D array of doubles (mdspan-style).
+     *
+     * Rows may be padded: consecutive rows start rowStride values apart. Copying a view
+     * never copies the underlying data.
+     */
+    class FieldView {
+    private:
+        const double* data_;      /**< First value of the first row */
+        int rows_;                /**< Number of rows */
+        int cols_;                /**< Number of values per row */
+        std::ptrdiff_t rowStride_; /**< Distance between the starts of two rows, in values */
+
+    public:
+        /**
+         * @brief Creates an empty view.
+         */
+        FieldView() : data_(nullptr), rows_(0), cols_(0), rowStride_(0) {}
+
+        /**
+         * @brief Creates a view over existing data.
+         *
+         * @param data First value of the first row
+         * @param rows Number of rows
+         * @param cols Number of values per row
+         * @param rowStride Distance between two rows in values (defaults to cols)
+         */
+        FieldView(const double* data, int rows, int cols, std::ptrdiff_t rowStride = -1)
+            : data_(data), rows_(rows), cols_(cols), rowStride_(rowStride < 0 ? cols : rowStride) {}
+
+        int rows() const { return rows_; }
+        int cols() const { return cols_; }
+        std::ptrdiff_t rowStride() const { return rowStride_; }
+        const double* data() const { return data_; }
+        bool empty() const { return data_ == nullptr || rows_ == 0 || cols_ == 0; }
+
+        /**
+         * @brief Returns a pointer to the first value of a row.
+         *
+         * @param r Row index (0 to rows-1)
+         */
+        const double* row(int r) const { return data_ + r * rowStride_; }
+
+        /**
+         * @brief Returns the value at (r, c).
+         */
+        double operator()(int r, int c) const { return data_[r * rowStride_ + c]; }
+    };
+
+    /**
+     * @brief Non-owning, read-only view of a frame-major sequence of 2D fields.
+     *
+     * Frame t starts frameStride values after frame t-1; each frame is a FieldView.
+     */
+    class FieldSequenceView {
+    private:
+        const double* data_;         /**< First value of the first frame */
+        int frames_;                 /**< Number of frames */
+        int rows_;                   /**< Number of rows per frame */
+        int cols_;                   /**< Number of values per row */
+        std::ptrdiff_t rowStride_;   /**< Distance between two rows, in values */
+        std::ptrdiff_t frameStride_; /**< Distance between two frames, in values */
+
+    public:
+        /**
+         * @brief Creates an empty view.
+         */
+        FieldSequenceView() : data_(nullptr), frames_(0), rows_(0), cols_(0), rowStride_(0), frameStride_(0) {}
+
+        /**
+         * @brief Creates a view over existing data.
+         *
+         * @param data First value of the first frame
+         * @param frames Number of frames
+         * @param rows Number of rows per frame
+         * @param cols Number of values per row
+         * @param rowStride Distance between two rows in values
+         * @param frameStride Distance between two frames in values
+         */
+        FieldSequenceView(const double* data, int frames, int rows, int cols, std::ptrdiff_t rowStride, std::ptrdiff_t frameStride)
+            : data_(data), frames_(frames), rows_(rows), cols_(cols), rowStride_(rowStride), frameStride_(frameStride) {}
+
+        int frames() const { return frames_; }
+        int rows() const { return rows_; }
+        int cols() const { return cols_; }
+        std::ptrdiff_t rowStride() const { return rowStride_; }
+        std::ptrdiff_t frameStride() const { return frameStride_; }
+        const double* data() const { return data_; }
+        bool empty() const { return data_ == nullptr || frames_ == 0; }
+
+        /**
+         * @brief Returns a view of one frame.
+         *
+         * @param t Frame index (0 to frames-1)
+         */
+        FieldView frame(int t) const { return FieldView(data_ + t * frameStride_, rows_, cols_, rowStride_); }
+
+        /**
+         * @brief Returns the value at (t, r, c).
+         */
+        double operator()(int t, int r, int c) const { return data_[t * frameStride_ + r * rowStride_ + c]; }
+    };
+
+}
+
+#endif
@@ -0,0 +1,265 @@
+#include "FrameExporter.h"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+#include "Tracer.h"
+
+namespace heat {
+
+    namespace {
+
+        void appendBigEndian(std::vector<std::uint8_t>& out, std::uint32_t value) {
+            out.push_back(static_cast<std::uint8_t>(value >> 24));
+            out.push_back(static_cast<std::uint8_t>(value >> 16));
+            out.push_back(static_cast<std::uint8_t>(value >> 8));
+            out.push_back(static_cast<std::uint8_t>(value));
+        }
+
+        std::uint32_t crc32(const std::uint8_t* data, std::size_t size) {
+            static const std::vector<std::uint32_t> table = [] {
+                std::vector<std::uint32_t> t(256);
+                for (std::uint32_t n = 0; n < 256; ++n) {
+                    std::uint32_t c = n;
+                    for (int k = 0; k < 8; ++k) {
+                        c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                    }
+                    t[n] = c;
+                }
+                return t;
+            }();
+            std::uint32_t crc = 0xFFFFFFFFu;
+            for (std::size_t i = 0; i < size; ++i) {
+                crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+            }
+            return crc ^ 0xFFFFFFFFu;
+        }
+
+        void appendChunk(std::vector<std::uint8_t>& png, const char* type, const std::vector<std::uint8_t>& data) {
+            appendBigEndian(png, static_cast<std::uint32_t>(data.size()));
+            std::size_t start = png.size();
+            png.insert(png.end(), type, type + 4);
+            png.insert(png.end(), data.begin(), data.end());
+            appendBigEndian(png, crc32(png.data() + start, png.size() - start));
+        }
+
+        void writeFile(const std::string& path, const std::vector<std::uint8_t>& bytes) {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+            if (!out) {
+                throw std::runtime_error("Failed to write " + path);
+            }
+        }
+
+    }
+
+    void writePPM(const std::string& path, int width, int height, const std::uint32_t* pixels) {
+        std::string header = "P6\n" + std::to_string(width) + " " + std::to_string(height) + "\n255\n";
+        std::vector<std::uint8_t> bytes(header.begin(), header.end());
+        bytes.reserve(header.size() + static_cast<std::size_t>(width) * height * 3);
+        for (int i = 0; i < width * height; ++i) {
+            bytes.push_back(static_cast<std::uint8_t>(pixels[i] >> 16));
+            bytes.push_back(static_cast<std::uint8_t>(pixels[i] >> 8));
+            bytes.push_back(static_cast<std::uint8_t>(pixels[i]));
+        }
+        writeFile(path, bytes);
+    }
+
+    void writePNG(const std::string& path, int width, int height, const std::uint32_t* pixels) {
+        /** Raw scanlines: filter byte 0 followed by RGB triplets */
+        std::vector<std::uint8_t> raw;
+        raw.reserve(static_cast<std::size_t>(height) * (width * 3 + 1));
+        for (int y = 0; y < height; ++y) {
+            raw.push_back(0);
+            for (int x = 0; x < width; ++x) {
+                std::uint32_t p = pixels[static_cast<std::size_t>(y) * width + x];
+                raw.push_back(static_cast<std::uint8_t>(p >> 16));
+                raw.push_back(static_cast<std::uint8_t>(p >> 8));
+                raw.push_back(static_cast<std::uint8_t>(p));
+            }
+        }
+
+        /** zlib stream made of stored (uncompressed) deflate blocks */
+        std::vector<std::uint8_t> zlib = {0x78, 0x01};
+        std::size_t offset = 0;
+        do {
+            std::size_t length = std::min<std::size_t>(65535, raw.size() - offset);
+            bool last = offset + length == raw.size();
+            zlib.push_back(last ? 1 : 0);
+            zlib.push_back(static_cast<std::uint8_t>(length));
+            zlib.push_back(static_cast<std::uint8_t>(length >> 8));
+            zlib.push_back(static_cast<std::uint8_t>(~length));
+            zlib.push_back(static_cast<std::uint8_t>(~length >> 8));
+            zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + length);
+            offset += length;
+        } while (offset < raw.size());
+        std::uint32_t a = 1, b = 0;
+        for (std::uint8_t byte : raw) {
+            a = (a + byte) % 65521;
+            b = (b + a) % 65521;
+        }
+        appendBigEndian(zlib, (b << 16) | a);
+
+        std::vector<std::uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        std::vector<std::uint8_t> header;
+        appendBigEndian(header, static_cast<std::uint32_t>(width));
+        appendBigEndian(header, static_cast<std::uint32_t>(height));
+        header.insert(header.end(), {8, 2, 0, 0, 0}); /** 8-bit RGB, deflate, no filter, no interlace */
+        appendChunk(png, "IHDR", header);
+        appendChunk(png, "IDAT", zlib);
+        appendChunk(png, "IEND", {});
+        writeFile(path, png);
+    }
+
+    FrameExporter::FrameExporter(const std::string& pathPrefix, ExportFormat format, ColormapKind kind,
+                                 double minValue, double maxValue, int workerCount, int fps)
+        : prefix_(pathPrefix), format_(format), colormap_(kind), minValue_(minValue), maxValue_(maxValue), fps_(fps),
+          maxQueued_(static_cast<std::size_t>(2 * std::max(1, workerCount))), submitted_(0), written_(0), stopping_(false),
+          nextVideoFrame_(0), videoWidth_(0), videoHeight_(0) {
+        if (format_ == ExportFormat::Y4M) {
+            video_.open(prefix_ + ".y4m", std::ios::binary | std::ios::trunc);
+            if (!video_) {
+                throw std::runtime_error("Failed to open " + prefix_ + ".y4m");
+            }
+        }
+        for (int w = 0; w < std::max(1, workerCount); ++w) {
+            workers_.emplace_back(&FrameExporter::workerLoop, this);
+        }
+    }
+
+    FrameExporter::~FrameExporter() {
+        finish();
+    }
+
+    std::string FrameExporter::imagePath(int index) const {
+        char number[16];
+        std::snprintf(number, sizeof(number), "_%05d", index);
+        return prefix_ + number + (format_ == ExportFormat::PNG ? ".png" : ".ppm");
+    }
+
+    void FrameExporter::submit(const FieldView& frame) {
+        Job job;
+        job.rows = frame.rows();
+        job.cols = frame.cols();
+        job.values.resize(static_cast<std::size_t>(job.rows) * job.cols);
+        for (int i = 0; i < job.rows; ++i) {
+            std::copy(frame.row(i), frame.row(i) + job.cols, job.values.begin() + static_cast<std::size_t>(i) * job.cols);
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        jobTaken_.wait(lock, [&] { return queue_.size() < maxQueued_; }); /** Backpressure on the solver */
+        job.index = submitted_++;
+        queue_.push_back(std::move(job));
+        jobReady_.notify_one();
+    }
+
+    FrameSink FrameExporter::sink() {
+        return [this](int, const FieldView& frame) { submit(frame); };
+    }
+
+    void FrameExporter::workerLoop() {
+        Tracer::global().nameThread("exporter");
+        while (true) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                jobReady_.wait(lock, [&] { return stopping_ || !queue_.empty(); });
+                if (queue_.empty()) {
+                    return;
+                }
+                job = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            jobTaken_.notify_all();
+
+            bool failed = false;
+            try {
+                encode(job);
+            } catch (const std::exception& e) {
+                std::cerr << "Frame export error: " << e.what() << ", frame " << job.index << " skipped" << std::endl;
+                failed = true;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (failed && format_ == ExportFormat::Y4M && job.index >= nextVideoFrame_ && pendingVideo_.count(job.index) == 0) {
+                    storeVideoFrame(job.index, {}); /** Without its slot every later frame would wait forever */
+                }
+                ++written_;
+            }
+            jobTaken_.notify_all();
+        }
+    }
+
+    void FrameExporter::encode(const Job& job) {
+        std::vector<std::uint32_t> pixels(job.values.size());
+        colormap_.colorize(job.values.data(), static_cast<int>(job.values.size()), minValue_, maxValue_, pixels.data());
+
+        if (format_ == ExportFormat::PPM) {
+            writePPM(imagePath(job.index), job.cols, job.rows, pixels.data());
+            return;
+        }
+        if (format_ == ExportFormat::PNG) {
+            writePNG(imagePath(job.index), job.cols, job.rows, pixels.data());
+            return;
+        }
+
+        /** Y4M: BT.601 limited-range Y, Cb and Cr planes, written strictly in frame order */
+        std::size_t count = pixels.size();
+        std::vector<std::uint8_t> planes(3 * count);
+        for (std::size_t i = 0; i < count; ++i) {
+            double r = (pixels[i] >> 16) & 0xFF, g = (pixels[i] >> 8) & 0xFF, b = pixels[i] & 0xFF;
+            planes[i] = static_cast<std::uint8_t>(16.0 + (65.481 * r + 128.553 * g + 24.966 * b) / 255.0 + 0.5);
+            planes[count + i] = static_cast<std::uint8_t>(128.0 + (-37.797 * r - 74.203 * g + 112.0 * b) / 255.0 + 0.5);
+            planes[2 * count + i] = static_cast<std::uint8_t>(128.0 + (112.0 * r - 93.786 * g - 18.214 * b) / 255.0 + 0.5);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (videoWidth_ == 0) {
+            videoWidth_ = job.cols;
+            videoHeight_ = job.rows;
+            video_ << "YUV4MPEG2 W" << videoWidth_ << " H" << videoHeight_ << " F" << fps_ << ":1 Ip A1:1 C444\n";
+        }
+        if (job.cols != videoWidth_ || job.rows != videoHeight_) {
+            std::cerr << "Frame export error: Y4M frames must all have the same size, frame " << job.index << " skipped" << std::endl;
+            planes.clear(); /** Keep the slot so the following frames are still written */
+        }
+        storeVideoFrame(job.index, std::move(planes));
+    }
+
+    void FrameExporter::storeVideoFrame(int index, std::vector<std::uint8_t> planes) {
+        pendingVideo_[index] = std::move(planes);
+        for (auto it = pendingVideo_.find(nextVideoFrame_); it != pendingVideo_.end(); it = pendingVideo_.find(nextVideoFrame_)) {
+            if (!it->second.empty()) {
+                video_ << "FRAME\n";
+                video_.write(reinterpret_cast<const char*>(it->second.data()), static_cast<std::streamsize>(it->second.size()));
+            }
+            pendingVideo_.erase(it);
+            ++nextVideoFrame_;
+        }
+    }
+
+    void FrameExporter::finish() {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (stopping_) {
+                return;
+            }
+            jobTaken_.wait(lock, [&] { return written_ == submitted_; });
+            stopping_ = true;
+        }
+        jobReady_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+        if (video_.is_open()) {
+            video_.close();
+        }
+    }
+
+    int FrameExporter::framesWritten() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return written_;
+    }
+
+}
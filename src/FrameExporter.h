@@ -0,0 +1,154 @@
+#ifndef FRAME_EXPORTER_H
+#define FRAME_EXPORTER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Colormap.h"
+#include "FieldView.h"
+#include "Snapshot.h"
+
+namespace heat {
+
+    /**
+     * @brief Output format of a FrameExporter.
+     */
+    enum class ExportFormat {
+        PPM, /**< One binary PPM (P6) image per frame: prefix_00000.ppm, prefix_00001.ppm, ... */
+        PNG, /**< One PNG image per frame: prefix_00000.png, prefix_00001.png, ... */
+        Y4M  /**< All frames in one YUV4MPEG2 (4:4:4) video stream: prefix.y4m */
+    };
+
+    /**
+     * @brief Headless output backend writing colorized temperature frames to disk.
+     *
+     * Needs no display and no SDL. submit() copies the frame and returns; worker threads
+     * colorize it with the same Colormap as the visualizers and encode it, so the solver
+     * keeps running meanwhile. When too many frames are queued, submit() waits.
+     */
+    class FrameExporter {
+    private:
+        /**
+         * @brief Frame waiting to be encoded.
+         */
+        struct Job {
+            int index;                  /**< Position of the frame in the output */
+            int rows;                   /**< Rows of the frame (image height) */
+            int cols;                   /**< Values per row (image width) */
+            std::vector<double> values; /**< Copy of the frame, row-major */
+        };
+
+        std::string prefix_;       /**< Output path without index and extension */
+        ExportFormat format_;      /**< Output format */
+        Colormap colormap_;        /**< Temperature color scale */
+        double minValue_;          /**< Value mapped to the first color */
+        double maxValue_;          /**< Value mapped to the last color */
+        int fps_;                  /**< Frame rate written in the Y4M header */
+
+        std::vector<std::thread> workers_;  /**< Encoding threads */
+        std::mutex mutex_;                  /**< Protects the fields below */
+        std::condition_variable jobReady_;  /**< Signals queued jobs (or shutdown) to the workers */
+        std::condition_variable jobTaken_;  /**< Signals free queue space and finished jobs */
+        std::deque<Job> queue_;             /**< Frames waiting for a worker */
+        std::size_t maxQueued_;             /**< Queue length at which submit() waits */
+        int submitted_;                     /**< Frames submitted so far */
+        int written_;                       /**< Frames fully written */
+        bool stopping_;                     /**< Set by finish() */
+
+        std::ofstream video_;                          /**< Y4M output stream */
+        std::map<int, std::vector<std::uint8_t>> pendingVideo_; /**< Encoded Y4M frames waiting for their turn */
+        int nextVideoFrame_;                           /**< Index of the next Y4M frame to write */
+        int videoWidth_;                               /**< Width fixed by the first Y4M frame */
+        int videoHeight_;                              /**< Height fixed by the first Y4M frame */
+
+        /**
+         * @brief Main loop of the encoding threads.
+         */
+        void workerLoop();
+
+        /**
+         * @brief Colorizes and writes one frame.
+         */
+        void encode(const Job& job);
+
+        /**
+         * @brief Queues an encoded Y4M frame and writes every frame whose turn has come.
+         *
+         * Must be called with mutex_ held. An empty frame only keeps its slot: nothing is written for it.
+         */
+        void storeVideoFrame(int index, std::vector<std::uint8_t> planes);
+
+        /**
+         * @brief Path of the numbered image file of a frame.
+         */
+        std::string imagePath(int index) const;
+
+    public:
+        /**
+         * @brief Starts the encoding threads.
+         *
+         * @param pathPrefix Output path without extension (e.g. "out/copper_2D")
+         * @param format Output format
+         * @param kind Temperature color scale
+         * @param minValue Temperature mapped to the first color
+         * @param maxValue Temperature mapped to the last color
+         * @param workerCount Number of encoding threads (>= 1)
+         * @param fps Frame rate of the Y4M stream
+         */
+        FrameExporter(const std::string& pathPrefix, ExportFormat format, ColormapKind kind,
+                      double minValue, double maxValue, int workerCount = 2, int fps = 10);
+
+        /**
+         * @brief Writes the remaining frames and stops the threads.
+         */
+        ~FrameExporter();
+
+        FrameExporter(const FrameExporter&) = delete;
+        FrameExporter& operator=(const FrameExporter&) = delete;
+
+        /**
+         * @brief Queues a copy of a frame for encoding.
+         *
+         * @param frame Frame to write (row i becomes image row i)
+         */
+        void submit(const FieldView& frame);
+
+        /**
+         * @brief Returns a snapshot sink submitting every frame it receives.
+         */
+        FrameSink sink();
+
+        /**
+         * @brief Waits until every submitted frame is written, then stops the threads.
+         */
+        void finish();
+
+        /**
+         * @brief Number of frames fully written so far.
+         */
+        int framesWritten();
+    };
+
+    /**
+     * @brief Writes packed ARGB pixels as a binary PPM (P6) image.
+     *
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void writePPM(const std::string& path, int width, int height, const std::uint32_t* pixels);
+
+    /**
+     * @brief Writes packed ARGB pixels as an 8-bit RGB PNG image (stored deflate blocks).
+     *
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void writePNG(const std::string& path, int width, int height, const std::uint32_t* pixels);
+
+}
+
+#endif
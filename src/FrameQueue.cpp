@@ -0,0 +1,79 @@
+#include "FrameQueue.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace heat {
+
+    FrameQueue::FrameQueue(int capacity, int rows, int cols, bool dropWhenFull)
+        : capacity_(capacity > 0 ? capacity : 1), rows_(rows), cols_(cols), rowStride_((cols + 7) & ~7),
+          dropWhenFull_(dropWhenFull),
+          slots_(static_cast<std::size_t>(capacity > 0 ? capacity : 1) * rows * ((cols + 7) & ~7)),
+          steps_(capacity > 0 ? capacity : 1, -1), head_(0), tail_(0), closed_(false), cancelled_(false), dropped_(0) {}
+
+    bool FrameQueue::push(int timeStep, const FieldView& frame) {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        while (tail - head_.load(std::memory_order_acquire) >= static_cast<std::size_t>(capacity_)) {
+            if (cancelled_.load(std::memory_order_relaxed)) {
+                return false;
+            }
+            if (dropWhenFull_) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            /** Backpressure: the consumer may hold its slots for a whole frame interval, so sleep instead of spinning */
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        if (cancelled_.load(std::memory_order_relaxed)) {
+            return false;
+        }
+
+        std::size_t slot = tail % capacity_;
+        double* out = slots_.data() + slot * rows_ * rowStride_;
+        for (int i = 0; i < rows_; ++i) {
+            std::copy(frame.row(i), frame.row(i) + cols_, out + static_cast<std::size_t>(i) * rowStride_);
+        }
+        steps_[slot] = timeStep;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    void FrameQueue::close() {
+        closed_.store(true, std::memory_order_release);
+    }
+
+    bool FrameQueue::front(FieldView& frame, int& timeStep) const {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        std::size_t slot = head % capacity_;
+        frame = FieldView(slots_.data() + slot * rows_ * rowStride_, rows_, cols_, rowStride_);
+        timeStep = steps_[slot];
+        return true;
+    }
+
+    void FrameQueue::release() {
+        head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    bool FrameQueue::waitFront(FieldView& frame, int& timeStep) const {
+        while (!front(frame, timeStep)) {
+            if (closed_.load(std::memory_order_acquire)) {
+                /** Re-check: the last frame may have been pushed just before closing */
+                return front(frame, timeStep);
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        return true;
+    }
+
+    void FrameQueue::cancel() {
+        cancelled_.store(true, std::memory_order_relaxed);
+    }
+
+    bool FrameQueue::finished() const {
+        return closed_.load(std::memory_order_acquire) && head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+}
@@ -0,0 +1,105 @@
+#ifndef FRAME_QUEUE_H
+#define FRAME_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+#include "AlignedBuffer.h"
+#include "FieldView.h"
+
+namespace heat {
+
+    /**
+     * @brief Bounded lock-free single-producer/single-consumer queue of frames.
+     *
+     * The slots are allocated once and recycled: the producer (solver thread) copies each
+     * frame into the next free slot, the consumer (render thread) reads it in place and
+     * releases it. When the queue is full the producer either waits (backpressure) or drops
+     * the frame, depending on the mode.
+     */
+    class FrameQueue {
+    private:
+        int capacity_;                  /**< Number of slots */
+        int rows_;                      /**< Rows per frame */
+        int cols_;                      /**< Values per row */
+        int rowStride_;                 /**< cols_ padded to a cache line */
+        bool dropWhenFull_;             /**< Drop frames instead of waiting when full */
+        AlignedBuffer slots_;           /**< capacity_ frames, frame-major */
+        std::vector<int> steps_;        /**< Time step held by each slot */
+        alignas(64) std::atomic<std::size_t> head_; /**< Frames consumed (written by the consumer) */
+        alignas(64) std::atomic<std::size_t> tail_; /**< Frames produced (written by the producer) */
+        std::atomic<bool> closed_;      /**< No more frames will be produced */
+        std::atomic<bool> cancelled_;   /**< The consumer stopped; pushes are discarded */
+        std::atomic<int> dropped_;      /**< Frames dropped because the queue was full */
+
+    public:
+        /**
+         * @brief Allocates the slots.
+         *
+         * @param capacity Number of frames that can be in flight
+         * @param rows Rows per frame
+         * @param cols Values per row
+         * @param dropWhenFull Drop new frames instead of blocking the producer when full
+         */
+        FrameQueue(int capacity, int rows, int cols, bool dropWhenFull = false);
+
+        FrameQueue(const FrameQueue&) = delete;
+        FrameQueue& operator=(const FrameQueue&) = delete;
+
+        /**
+         * @brief Producer: copies a frame into the next slot.
+         *
+         * @return false if the frame was dropped (queue full in drop mode, or cancelled)
+         */
+        bool push(int timeStep, const FieldView& frame);
+
+        /**
+         * @brief Producer: signals that no more frames will be pushed.
+         */
+        void close();
+
+        /**
+         * @brief Consumer: returns the oldest frame without removing it.
+         *
+         * @param frame Receives a view of the slot (valid until release())
+         * @param timeStep Receives the time step of the frame
+         * @return false if the queue is currently empty
+         */
+        bool front(FieldView& frame, int& timeStep) const;
+
+        /**
+         * @brief Consumer: frees the slot returned by front().
+         */
+        void release();
+
+        /**
+         * @brief Consumer: waits for the next frame.
+         *
+         * @return false once the queue is closed and empty
+         */
+        bool waitFront(FieldView& frame, int& timeStep) const;
+
+        /**
+         * @brief Consumer: stops consuming; pending and future pushes are discarded.
+         */
+        void cancel();
+
+        /**
+         * @brief Whether the producer closed the queue and every frame was consumed.
+         */
+        bool finished() const;
+
+        /**
+         * @brief Number of frames waiting to be consumed (exact for the consumer, a snapshot otherwise).
+         */
+        int size() const { return static_cast<int>(tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire)); }
+
+        /**
+         * @brief Number of frames dropped so far.
+         */
+        int dropped() const { return dropped_.load(); }
+    };
+
+}
+
+#endif
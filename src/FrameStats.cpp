@@ -0,0 +1,57 @@
+#include "FrameStats.h"
+#include <limits>
+
+namespace heat {
+
+    FrameStats::FrameStats() : FrameStats(0.0, 1.0) {}
+
+    FrameStats::FrameStats(double low, double high) : low(low), high(high) {
+        reset();
+    }
+
+    void FrameStats::reset() {
+        min = std::numeric_limits<double>::infinity();
+        max = -std::numeric_limits<double>::infinity();
+        sum = 0.0;
+        count = 0;
+        histogram.fill(0);
+    }
+
+    double FrameStats::accumulate(const double* values, int n) {
+        double range = high - low;
+        double scale = range > 0.0 ? bins / range : 0.0;
+        const double top = bins - 1;
+
+        double runMin = min;
+        double runMax = max;
+        double runSum = 0.0;
+        for (int i = 0; i < n; ++i) {
+            double v = values[i];
+            runMin = v < runMin ? v : runMin;
+            runMax = v > runMax ? v : runMax;
+            runSum += v;
+
+            /** Clamped bin index, same normalization as Colormap::colorize */
+            double x = (v - low) * scale;
+            x = x < top ? x : top;
+            x = x > 0.0 ? x : 0.0;
+            ++histogram[static_cast<int>(x)];
+        }
+        min = runMin;
+        max = runMax;
+        sum += runSum;
+        count += n;
+        return runSum;
+    }
+
+    void FrameStats::merge(const FrameStats& other) {
+        if (other.min < min) min = other.min;
+        if (other.max > max) max = other.max;
+        sum += other.sum;
+        count += other.count;
+        for (int b = 0; b < bins; ++b) {
+            histogram[b] += other.histogram[b];
+        }
+    }
+
+}
@@ -0,0 +1,71 @@
+#ifndef FRAME_STATS_H
+#define FRAME_STATS_H
+
+#include <array>
+
+namespace heat {
+
+    /**
+     * @brief Summary of the values of one frame: extremes, mean and a coarse histogram.
+     *
+     * The solvers fill one FrameStats per time step while the frame is still in cache, so
+     * color scaling never needs a second pass over the data. Values outside the histogram
+     * range are counted in the first or last bin.
+     */
+    struct FrameStats {
+        static constexpr int bins = 32; /** Number of histogram bins */
+
+        double min;    /** Smallest value */
+        double max;    /** Largest value */
+        double sum;    /** Sum of the values */
+        long long count; /** Number of values (0 = not computed) */
+        double low;    /** Value at the start of the first bin */
+        double high;   /** Value at the end of the last bin */
+        std::array<int, bins> histogram; /** Number of values per bin */
+
+        /**
+         * @brief Empty statistics (count 0) with the histogram range [0, 1].
+         */
+        FrameStats();
+
+        /**
+         * @brief Empty statistics with a given histogram range.
+         *
+         * @param low Value at the start of the first bin
+         * @param high Value at the end of the last bin
+         */
+        FrameStats(double low, double high);
+
+        /**
+         * @brief Clears the statistics, keeping the histogram range.
+         */
+        void reset();
+
+        /**
+         * @brief Adds a run of values.
+         *
+         * @param values First value
+         * @param n Number of values
+         * @return Sum of the added values (for callers that need a fixed summation order)
+         */
+        double accumulate(const double* values, int n);
+
+        /**
+         * @brief Adds the statistics of another part of the same frame (same histogram range).
+         */
+        void merge(const FrameStats& other);
+
+        /**
+         * @brief Mean value (0 if no value was added).
+         */
+        double mean() const { return count > 0 ? sum / count : 0.0; }
+
+        /**
+         * @brief Value at the start of a histogram bin.
+         */
+        double binStart(int bin) const { return low + (high - low) * bin / bins; }
+    };
+
+}
+
+#endif
@@ -1,22 +1,74 @@
 #include "HeatEquationSolver1D.h"
+#include <utility>
+#include "Metrics.h"
+#include "Tracer.h"
 
 namespace heat {
 
     void HeatEquationSolver1D::initializeMatrix() {
-        temperatureMatrix = new double*[M];
-        for (int t = 0; t < M; ++t) {
-            temperatureMatrix[t] = new double[N];
-            for (int x = 0; x < N; ++x) {
-                temperatureMatrix[t][x] = u0;
-            }
+        /** Single allocation reused across solves; rows are padded to keep each one aligned */
+        temperatureMatrix.resize(static_cast<std::size_t>(storedRows) * rowStride);
+        temperatureMatrix.fill(u0);
+    }
+
+    double* HeatEquationSolver1D::row(int timeStep) {
+        /** In rolling mode even and odd time steps alternate between the two rows */
+        int r = storageMode == StorageMode::Rolling ? timeStep % 2 : timeStep;
+        return temperatureMatrix.data() + static_cast<std::size_t>(r) * rowStride;
+    }
+
+    const double* HeatEquationSolver1D::row(int timeStep) const {
+        int r = storageMode == StorageMode::Rolling ? timeStep % 2 : timeStep;
+        return temperatureMatrix.data() + static_cast<std::size_t>(r) * rowStride;
+    }
+
+    void HeatEquationSolver1D::emitSnapshot(int timeStep) const {
+        if (storageMode != StorageMode::Rolling || !snapshotSink) {
+            return;
+        }
+        if (snapshotPolicy.selects(timeStep, M - 1)) {
+            snapshotSink(timeStep, row(timeStep), N);
         }
     }
 
-    void HeatEquationSolver1D::deallocateMatrix() {
-        for (int t = 0; t < M; ++t) {
-            delete[] temperatureMatrix[t];
+    void HeatEquationSolver1D::updateSourceCache() {
+        if (sourceCacheValid && sourceCacheDt == dt) {
+            return;
+        }
+        HEAT_METRIC_SCOPE(MetricPhase::SourceEvaluation, sizeof(double) * N);
+        sourceTerm.resize(N);
+        for (int x = 0; x < N; ++x) {
+            sourceTerm[x] = dt * source.F(x * dx) / (material.density * material.specificHeat);
         }
-        delete[] temperatureMatrix;
+        sourceCacheValid = true;
+        sourceCacheDt = dt;
+    }
+
+    void HeatEquationSolver1D::setSource(const Heatsource1D& newSource) {
+        source = newSource;
+        sourceCacheValid = false;
+    }
+
+    void HeatEquationSolver1D::setFullStorage() {
+        storageMode = StorageMode::Full;
+        storedRows = M;
+        snapshotPolicy = SnapshotPolicy::every(1);
+        snapshotSink = nullptr;
+        lastStep = 0;
+        initializeMatrix();
+    }
+
+    void HeatEquationSolver1D::setRollingStorage(int stride, SnapshotSink sink) {
+        setRollingStorage(SnapshotPolicy::every(stride), std::move(sink));
+    }
+
+    void HeatEquationSolver1D::setRollingStorage(const SnapshotPolicy& policy, SnapshotSink sink) {
+        storageMode = StorageMode::Rolling;
+        storedRows = 2;
+        snapshotPolicy = policy;
+        snapshotSink = std::move(sink);
+        lastStep = 0;
+        initializeMatrix();
     }
 
     void HeatEquationSolver1D::applyNeumannBoundary(double* currentRow) {
@@ -27,100 +79,149 @@ namespace heat {
         currentRow[N - 1] = u0; /** Dirichlet boundary condition (fixed temperature) */
     }
 
-    void HeatEquationSolver1D::solveTridiagonal(double* a, double* b, double* c, double* d, int N) {
-        double* c_star = new double[N];
-        double* d_star = new double[N];
-
-        /** Forward sweep */
-        c_star[0] = c[0] / b[0];
-        d_star[0] = d[0] / b[0];
-        for (int i = 1; i < N; ++i) {
-            double m = 1.0 / (b[i] - a[i - 1] * c_star[i - 1]);
-            c_star[i] = c[i] * m;
-            d_star[i] = (d[i] - a[i - 1] * d_star[i - 1]) * m;
-        }
-
-        /** Back substitution */
-        d[N - 1] = d_star[N - 1];
-        for (int i = N - 2; i >= 0; --i) {
-            d[i] = d_star[i] - c_star[i] * d[i + 1];
+    void HeatEquationSolver1D::solve() {
+        HEAT_TRACE_SCOPE("HeatEquationSolver1D::solve");
+        start();
+        while (advance()) {
         }
-
-        delete[] c_star;
-        delete[] d_star;
     }
 
-
-    void HeatEquationSolver1D::solve() {
+    void HeatEquationSolver1D::start() {
         /**  Initialize the temperature matrix */
         initializeMatrix();
 
+        /** Histogram range: u0 up to the temperature reached by pure heating during tmax */
+        FrameStats empty(u0, u0 + tmax * source.maxValue() / (material.density * material.specificHeat));
+        frameStats.assign(M, empty);
+        frameStats[0].accumulate(row(0), N);
+
         /**  Calculate the thermal diffusivity and the coefficient r */
         double alpha = material.conductivity / (material.density * material.specificHeat);
         double r = alpha * dt / (dx * dx);
 
-        double* a = new double[N - 1]; /** Sub-diagonal */
-        double* b = new double[N];     /** Main diagonal */
-        double* c = new double[N - 1]; /** Super-diagonal */
-        double* d = new double[N];     /** Right-hand side */
+        /** The source does not depend on time: evaluate it once per grid point */
+        updateSourceCache();
 
-        /** Initialize tridiagonal matrix coefficients*/
-        for (int i = 0; i < N - 1; ++i) {
-            a[i] = -r;
-            c[i] = -r;
-        }
-        for (int i = 0; i < N; ++i) {
-            b[i] = 1 + 2 * r;
-        }
+        /** Factor the constant tridiagonal matrix once for all time steps */
+        implicitOperator.factor(-r, 1 + 2 * r, -r, N);
+
+        rightHandSide.resize(N);
+        stopped = false;
+
+        lastStep = 0;
+        emitSnapshot(0);
+        runControl.reportProgress(0, M - 1);
+    }
 
-        /** Time-stepping loop */
-        for (int n = 0; n < M - 1; ++n) {
-            /** Construct the right-hand side vector */
+    bool HeatEquationSolver1D::advance() {
+        if (lastStep >= M - 1 || stopped) {
+            return false;
+        }
+        HEAT_TRACE_SCOPE("1D step");
+        const int n = lastStep;
+        const double* s = sourceTerm.data();
+        double* d = rightHandSide.data();     /** Right-hand side */
+
+        /** Construct the right-hand side vector */
+        const double* current = row(n);
+        {
+            HEAT_METRIC_SCOPE(MetricPhase::RhsAssembly, 3 * sizeof(double) * N);
             for (int x = 1; x < N - 1; ++x) {
-                d[x] = temperatureMatrix[n][x] +
-                       dt * source.F(x * dx) / (material.density * material.specificHeat);
+                d[x] = current[x] + s[x];
             }
 
             /** Apply boundary conditions to the right-hand side*/
-            d[0] = temperatureMatrix[n][0];       /** Neumann at x = 0 */
+            d[0] = current[0];                  /** Neumann at x = 0 */
             d[N - 1] = u0;                      /** Dirichlet at x = L */
+        }
 
-            /** Solve the tridiagonal system */
-            solveTridiagonal(a, b, c, d, N);
+        /** Solve the tridiagonal system */
+        {
+            HEAT_METRIC_SCOPE(MetricPhase::TridiagonalSolve, 4 * sizeof(double) * N); /** d twice, two factor arrays */
+            implicitOperator.apply(d);
+        }
 
-            /** Update the temperature matrix for the next time step */
+        /** Update the temperature matrix for the next time step */
+        double* next = row(n + 1);
+        {
+            HEAT_METRIC_SCOPE(MetricPhase::RowCopy, 2 * sizeof(double) * N);
             for (int x = 0; x < N; ++x) {
-                temperatureMatrix[n + 1][x] = d[x];
+                next[x] = d[x];
             }
+        }
+
+        /** Apply boundary conditions to the updated row */
+        {
+            HEAT_METRIC_SCOPE(MetricPhase::Boundary, 3 * sizeof(double));
+            applyNeumannBoundary(next);
+            applyDirichletBoundary(next);
+        }
+        frameStats[n + 1].accumulate(next, N); /** Row is still in cache */
 
-            /** Apply boundary conditions to the updated row */
-            applyNeumannBoundary(temperatureMatrix[n + 1]);
-            applyDirichletBoundary(temperatureMatrix[n + 1]);
+        lastStep = n + 1;
+        emitSnapshot(lastStep);
+
+        /** Publish progress and honor cancellation every few steps */
+        if (lastStep % controlInterval == 0 || lastStep == M - 1) {
+            runControl.reportProgress(lastStep, M - 1);
+            stopped = runControl.cancelled();
         }
+        return true;
+    }
 
-        /** clean up dynamically allocated memory for tridiagonal coefficients */
-        delete[] a;
-        delete[] b;
-        delete[] c;
-        delete[] d;
+    FieldView HeatEquationSolver1D::currentField() const {
+        return FieldView(row(lastStep), 1, N);
     }
 
     void HeatEquationSolver1D::printTemperatureMatrix(std::ostream& os) const {
         os << "Temperature Matrix (in Kelvin):\n";
-        for (int t = 0; t < M; ++t) {
+        int first = 0;
+        int last = M - 1;
+        if (storageMode == StorageMode::Rolling) {
+            first = lastStep > 0 ? lastStep - 1 : 0;
+            last = lastStep;
+        }
+        for (int t = first; t <= last; ++t) {
             os << "Time step " << t << " (t = " << t * dt << " s): ";
+            const double* values = row(t);
             for (int x = 0; x < N; ++x) {
-                os << temperatureMatrix[t][x] << " ";
+                os << values[x] << " ";
             }
             os << "\n";
         }
     }
 
     const double* HeatEquationSolver1D::getTemperatureAtTime(int timeStep) const {
-        if (timeStep >= 0 && timeStep < M) {
-            return temperatureMatrix[timeStep]; 
+        if (timeStep < 0 || timeStep >= M) {
+            return nullptr;
+        }
+        if (storageMode == StorageMode::Rolling && (timeStep > lastStep || timeStep < lastStep - 1)) {
+            return nullptr; /** No longer (or not yet) held in the two-row buffer */
+        }
+        return row(timeStep);
+    }
+
+    FieldView HeatEquationSolver1D::getTemperatureField() const {
+        return FieldView(temperatureMatrix.data(), storedRows, N, rowStride);
+    }
+
+    const FrameStats& HeatEquationSolver1D::getFrameStats(int timeStep) const {
+        static const FrameStats none;
+        if (timeStep < 0 || timeStep >= static_cast<int>(frameStats.size())) {
+            return none;
+        }
+        return frameStats[timeStep];
+    }
+
+    FrameStats HeatEquationSolver1D::getSummaryStats() const {
+        if (frameStats.empty()) {
+            return FrameStats();
+        }
+        FrameStats summary(frameStats[0].low, frameStats[0].high);
+        for (int t = 0; t <= lastStep; ++t) {
+            summary.merge(frameStats[t]);
         }
-        return nullptr;
+        return summary;
     }
 
 }
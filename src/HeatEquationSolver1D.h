@@ -2,13 +2,32 @@
 #define HEAT_EQUATIONOLVER_1D_H
 
 #include <iostream>
-#include "material.h"
+#include <functional>
+#include <vector>
+#include "AlignedBuffer.h"
+#include "FieldView.h"
+#include "FrameStats.h"
+#include "Material.h"
 #include "Heatsource1D.h"
+#include "RunControl.h"
+#include "Snapshot.h"
+#include "StepRange.h"
+#include "TridiagonalOperator.h"
 
 /**
  * @brief Solves the one-dimensional heat equation for a given material and heat source.
  */
 namespace heat {
+
+    /**
+     * @brief Callback receiving a snapshot of the temperature profile.
+     *
+     * @param timeStep The time step index of the snapshot
+     * @param temperature Pointer to the temperature profile (valid only during the call)
+     * @param size Number of values in the profile
+     */
+    using SnapshotSink = std::function<void(int timeStep, const double* temperature, int size)>;
+
     class HeatEquationSolver1D {
     private:
         Material material;    /**< Material properties */
@@ -21,17 +40,47 @@ namespace heat {
         double dx;            /**< Spatial step size */
         double dt;            /**< Time step size */
 
-        double** temperatureMatrix; /**< Dynamic 2D array for storing temperature values */
+        AlignedBuffer temperatureMatrix; /**< Contiguous storage for the temperature rows */
+        int rowStride;              /**< Distance between two stored rows (N padded to a cache line) */
+        StorageMode storageMode;    /**< Full history or rolling two-row storage */
+        int storedRows;             /**< Number of rows held in temperatureMatrix */
+        SnapshotPolicy snapshotPolicy; /**< Time steps sent to the sink (rolling mode) */
+        SnapshotSink snapshotSink;  /**< Receiver of the snapshots (rolling mode) */
+        int lastStep;               /**< Index of the most recently computed time step */
+        TridiagonalOperator implicitOperator; /**< Factored (I - r*Laplacian) matrix, reused by every time step */
+        AlignedBuffer sourceTerm;   /**< Cached dt * F(x) / (rho * c) for every grid point */
+        bool sourceCacheValid;      /**< Whether sourceTerm matches the current source */
+        double sourceCacheDt;       /**< Time step the cache was computed for */
+        RunControl runControl;      /**< Progress reporting and cancellation, checked every controlInterval steps */
+        static constexpr int controlInterval = 4; /**< Time steps between two progress/cancellation checks */
+        AlignedBuffer rightHandSide; /**< Right-hand side of the current step, solved in place */
+        bool stopped;               /**< Set when the run was cancelled */
+        std::vector<FrameStats> frameStats; /**< Statistics of every time step, filled while solving */
 
         /**
-         * @brief Initializes the dynamic memory for the temperature matrix.
+         * @brief Sizes the temperature matrix (allocating only if needed) and fills it with u0.
          */
         void initializeMatrix();
 
         /**
-         * @brief Deallocates the dynamic memory for the temperature matrix.
+         * @brief Returns the storage row holding a given time step.
+         *
+         * @param timeStep The time step index (0 to M-1)
          */
-        void deallocateMatrix();
+        double* row(int timeStep);
+        const double* row(int timeStep) const;
+
+        /**
+         * @brief Sends a time step to the snapshot sink if the snapshot policy selects it.
+         *
+         * @param timeStep The time step index that has just been computed
+         */
+        void emitSnapshot(int timeStep) const;
+
+        /**
+         * @brief Materializes the scaled source term if the source or dt changed since the last solve.
+         */
+        void updateSourceCache();
 
         /**
          * @brief Applies Neumann boundary condition at x = 0.
@@ -47,17 +96,6 @@ namespace heat {
          */
         void applyDirichletBoundary(double* currentRow);
 
-        /**
-         * @brief Solves a tridiagonal system of equations using the Thomas algorithm.
-         *
-         * @param a Sub-diagonal coefficients (size N-1).
-         * @param b Main diagonal coefficients (size N).
-         * @param c Super-diagonal coefficients (size N-1).
-         * @param d Right-hand side vector (size N).
-         * @param N Size of the tridiagonal system.
-         */
-        void solveTridiagonal(double* a, double* b, double* c, double* d, int N);
-
     public:
         /**
          * @brief Constructor to initialize the HeatEquationSolver1D object.
@@ -71,22 +109,87 @@ namespace heat {
          * @param M Number of time steps.
          */
         HeatEquationSolver1D(const Material& material, const Heatsource1D& source, double L, double tmax, double u0, int N, int M)
-            : material(material), source(source), L(L), tmax(tmax), u0(u0), N(N), M(M), dx(L / (N - 1)), dt(tmax / (M - 1)) {
+            : material(material), source(source), L(L), tmax(tmax), u0(u0), N(N), M(M), dx(L / (N - 1)), dt(tmax / (M - 1)),
+              rowStride((N + 7) & ~7), storageMode(StorageMode::Full), storedRows(M), snapshotPolicy(SnapshotPolicy::every(1)), lastStep(0),
+              sourceCacheValid(false), sourceCacheDt(0.0), stopped(false) {
                 initializeMatrix();
         }
 
         /**
-         * @brief Destructor to deallocate dynamic memory
+         * @brief Replace the heat source (invalidates the cached source term)
+         *
+         * @param newSource Heat source used by the next solve
          */
-        ~HeatEquationSolver1D() {
-            deallocateMatrix();
-        }
+        void setSource(const Heatsource1D& newSource);
+
+        /**
+         * @brief Keep every time step in memory (default).
+         */
+        void setFullStorage();
+
+        /**
+         * @brief Keep only the current and the next time step in memory.
+         *
+         * Memory becomes O(N) instead of O(M*N). Every stride-th time step, as well as the
+         * last one, is passed to the sink while it is computed.
+         *
+         * @param stride Snapshot interval in time steps (>= 1)
+         * @param sink Receiver of the snapshots (may be empty)
+         */
+        void setRollingStorage(int stride, SnapshotSink sink);
+
+        /**
+         * @brief Keep only the current and the next time step, with an arbitrary snapshot schedule.
+         *
+         * @param policy Time steps passed to the sink (step 0 and the last step always are)
+         * @param sink Receiver of the snapshots (may be empty)
+         */
+        void setRollingStorage(const SnapshotPolicy& policy, SnapshotSink sink);
+
+        /**
+         * @brief Share progress and cancellation with another thread.
+         *
+         * Every few time steps the solver publishes the number of steps done and stops early
+         * if the control was cancelled; the steps computed so far stay available.
+         */
+        void setRunControl(const RunControl& control) { runControl = control; }
+
+        /**
+         * @brief Index of the last time step computed (M - 1 after a complete solve).
+         */
+        int lastComputedStep() const { return lastStep; }
 
         /**
          * @brief Solve the heat equation using finite difference methods
+         * 
+         * Equivalent to start() followed by advance() until it returns false.
          */
         void solve();
 
+        /**
+         * @brief Prepares a solve: initial row, factored operator, source term; step 0 is ready
+         */
+        void start();
+
+        /**
+         * @brief Computes the next time step
+         *
+         * @return false (and computes nothing) if the last step was already reached or the run was cancelled
+         */
+        bool advance();
+
+        /**
+         * @brief View of the most recently computed row (1 x N), valid until the next advance()
+         */
+        FieldView currentField() const;
+
+        /**
+         * @brief Lazy range computing one time step per iteration
+         *
+         * Use with rolling storage to keep only two rows whatever the number of steps.
+         */
+        StepRange<HeatEquationSolver1D> steps() { return StepRange<HeatEquationSolver1D>(*this); }
+
         /**
          * @brief Print the temperature matrix to the specified output stream
          * 
@@ -97,11 +200,41 @@ namespace heat {
         /**
          * @brief Gets the temperature profile at a specific time step
          * 
+         * In rolling mode only the last two computed time steps are retained.
+         *
          * @param timeStep The time step index (0 to M-1)
-         * @return A pointer to the temperature profile at the specified time step
+         * @return A pointer to the temperature profile at the specified time step,
+         *         or nullptr if the time step is out of range or no longer retained
          */
         const double* getTemperatureAtTime(int timeStep) const;
 
+        /**
+         * @brief Gets a view of the stored temperature rows without copying them
+         *
+         * In full mode row t of the view is time step t. In rolling mode the view holds the
+         * two rows of the buffer, even time steps in row 0 and odd time steps in row 1.
+         *
+         * @return A view with one row per stored time step and N columns
+         */
+        FieldView getTemperatureField() const;
+
+        /**
+         * @brief Gets the statistics of a time step
+         *
+         * They are computed while the row is written, in every storage mode, and are complete
+         * before the row reaches the snapshot sink. The histogram spans u0 to the temperature
+         * the source alone could reach in tmax.
+         *
+         * @param timeStep The time step index (0 to M-1)
+         * @return The statistics (count 0 if the step is out of range or not computed yet)
+         */
+        const FrameStats& getFrameStats(int timeStep) const;
+
+        /**
+         * @brief Gets the statistics of every time step computed so far, merged
+         */
+        FrameStats getSummaryStats() const;
+
     };
 }
 
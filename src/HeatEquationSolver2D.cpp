@@ -1,79 +1,297 @@
 #include "HeatEquationSolver2D.h"
+#include <algorithm>
+#include <initializer_list>
+#include <utility>
+#include "Metrics.h"
+#include "Tracer.h"
 
 namespace heat {
 
     HeatEquationSolver2D::HeatEquationSolver2D(const Material& material, const Heatsource2D& source, double L, double tmax, double u0, int N, int M)
-        : material(material), source(source), L(L), tmax(tmax), u0(u0), N(N), M(M), dx(L / (N - 1)), dt(tmax / (M - 1)) {
-        temperatureGrids.resize(M, std::vector<std::vector<double>>(N, std::vector<double>(N, u0)));
+        : material(material), source(source), L(L), tmax(tmax), u0(u0), N(N), M(M), dx(L / (N - 1)), dt(tmax / (M - 1)),
+          rowStride((N + 7) & ~7), frameStride(static_cast<std::size_t>(N) * ((N + 7) & ~7)),
+          storageMode(StorageMode::Full), storedFrames(M), snapshotPolicy(SnapshotPolicy::every(1)), lastStep(0),
+          boundaries{BoundaryCondition::neumann(), BoundaryCondition::dirichlet(u0),
+                     BoundaryCondition::neumann(), BoundaryCondition::dirichlet(u0)},
+          sourceCacheValid(false), sourceCacheDt(0.0), linePartitioning(Partitioning::Static),
+          leftRhs(0.0), rightRhs(0.0), bottomRhs(0.0), topRhs(0.0), stopped(false) {
+        initializeFrames();
     }
 
-    void HeatEquationSolver2D::applyNeumannBoundary(std::vector<std::vector<double>>& grid) {
-        for (int y = 0; y < N; ++y) {
-            grid[0][y] = grid[1][y];  
+    void HeatEquationSolver2D::initializeFrames() {
+        /** A single allocation holds every stored frame, reused across solves */
+        temperatureGrids.resize(frameStride * storedFrames);
+        temperatureGrids.fill(u0);
+    }
+
+    double* HeatEquationSolver2D::frame(int timeStep) {
+        /** In rolling mode even and odd time steps alternate between the two frames */
+        int f = storageMode == StorageMode::Rolling ? timeStep % 2 : timeStep;
+        return temperatureGrids.data() + frameStride * f;
+    }
+
+    const double* HeatEquationSolver2D::frame(int timeStep) const {
+        int f = storageMode == StorageMode::Rolling ? timeStep % 2 : timeStep;
+        return temperatureGrids.data() + frameStride * f;
+    }
+
+    void HeatEquationSolver2D::emitSnapshot(int timeStep) const {
+        if (storageMode != StorageMode::Rolling || !snapshotSink) {
+            return;
+        }
+        if (snapshotPolicy.selects(timeStep, M - 1)) {
+            snapshotSink(timeStep, FieldView(frame(timeStep), N, N, rowStride));
         }
     }
 
-    void HeatEquationSolver2D::applyDirichletBoundary(std::vector<std::vector<double>>& grid) {
-        for (int y = 0; y < N; ++y) {
-            grid[N - 1][y] = u0; 
+    void HeatEquationSolver2D::setFullStorage() {
+        storageMode = StorageMode::Full;
+        storedFrames = M;
+        snapshotPolicy = SnapshotPolicy::every(1);
+        snapshotSink = nullptr;
+        lastStep = 0;
+        initializeFrames();
+    }
+
+    void HeatEquationSolver2D::setRollingStorage(const SnapshotPolicy& policy, FrameSink sink) {
+        storageMode = StorageMode::Rolling;
+        storedFrames = 2;
+        snapshotPolicy = policy;
+        snapshotSink = std::move(sink);
+        lastStep = 0;
+        initializeFrames();
+    }
+
+    void HeatEquationSolver2D::closeEdgeRows(double* grid) {
+        HEAT_METRIC_SCOPE(MetricPhase::Boundary, 4 * sizeof(double) * N);
+        double* first = grid;
+        double* last = grid + static_cast<std::size_t>(N - 1) * rowStride;
+        if (boundaries.left.type == BoundaryCondition::Type::Dirichlet) {
+            for (int y = 0; y < N; ++y) first[y] = boundaries.left.value;
+        } else {
+            double offset = boundaryRhs(boundaries.left, dx);
+            for (int y = 0; y < N; ++y) first[y] = first[rowStride + y] + offset;
+        }
+        if (boundaries.right.type == BoundaryCondition::Type::Dirichlet) {
+            for (int y = 0; y < N; ++y) last[y] = boundaries.right.value;
+        } else {
+            double offset = boundaryRhs(boundaries.right, dx);
+            for (int y = 0; y < N; ++y) last[y] = last[y - rowStride] + offset;
         }
     }
 
-    void HeatEquationSolver2D::solveTridiagonal(double* a, double* b, double* c, double* d, int size) {
-        std::vector<double> c_star(size), d_star(size);
+    void HeatEquationSolver2D::setBoundaryConditions(const BoundaryConditions2D& conditions) {
+        boundaries = conditions;
+    }
 
-        c_star[0] = c[0] / b[0];
-        d_star[0] = d[0] / b[0];
-        for (int i = 1; i < size; ++i) {
-            double m = 1.0 / (b[i] - a[i - 1] * c_star[i - 1]);
-            c_star[i] = c[i] * m;
-            d_star[i] = (d[i] - a[i - 1] * d_star[i - 1]) * m;
+    void HeatEquationSolver2D::updateSourceCache() {
+        if (sourceCacheValid && sourceCacheDt == dt) {
+            return;
         }
+        HEAT_METRIC_SCOPE(MetricPhase::SourceEvaluation, sizeof(double) * frameStride);
+        sourceTerm.resize(frameStride);
+        sourceTerm.fill(0.0);
+        for (int i = 0; i < N; ++i) {
+            for (int j = 0; j < N; ++j) {
+                sourceTerm[static_cast<std::size_t>(i) * rowStride + j] = dt * source.F(i * dx, j * dx) / (material.density * material.specificHeat);
+            }
+        }
+        sourceCacheValid = true;
+        sourceCacheDt = dt;
+    }
+
+    void HeatEquationSolver2D::setSource(const Heatsource2D& newSource) {
+        source = newSource;
+        sourceCacheValid = false;
+    }
+
+    void HeatEquationSolver2D::setThreadCount(int threads, Partitioning partitioning) {
+        linePartitioning = partitioning;
+        pool.reset();
+        if (threads <= 0) {
+            threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        }
+        if (threads > 1) {
+            pool.reset(new ThreadPool(threads));
+        }
+    }
 
-        d[size - 1] = d_star[size - 1];
-        for (int i = size - 2; i >= 0; --i) {
-            d[i] = d_star[i] - c_star[i] * d[i + 1];
+    void HeatEquationSolver2D::forEachLine(const ThreadPool::RangeTask& body, int grain) {
+        if (pool) {
+            pool->parallelFor(0, N, linePartitioning, body, grain);
+        } else {
+            body(0, N, 0);
         }
     }
 
     void HeatEquationSolver2D::solve() {
+        HEAT_TRACE_SCOPE("HeatEquationSolver2D::solve");
+        start();
+        while (advance()) {
+        }
+    }
+
+    void HeatEquationSolver2D::start() {
         double alpha = material.conductivity / (material.density * material.specificHeat);
         double r = alpha * dt / (dx * dx);
 
-        std::vector<double> a(N - 1, -r), b(N, 1 + 2 * r), c(N - 1, -r), d(N);
+        /** The source does not depend on time: evaluate it once per grid point */
+        updateSourceCache();
 
-        for (int t = 0; t < M - 1; ++t) {
-            // Implicit solve along x-direction
-            for (int j = 0; j < N; ++j) {
-                for (int i = 1; i < N - 1; ++i) {
-                    d[i] = temperatureGrids[t][i][j] + 
-                           dt * source.F(i * dx, j * dx) / (material.density * material.specificHeat);
-                }
-                applyNeumannBoundary(temperatureGrids[t]);
-                solveTridiagonal(a.data(), b.data(), c.data(), d.data(), N);
+        /** All lines of a sweep share one matrix: factor it once, edge conditions included */
+        factorLineOperator(xOperator, r, N, boundaries.left, boundaries.right);
+        factorLineOperator(yOperator, r, N, boundaries.bottom, boundaries.top);
+        leftRhs = boundaryRhs(boundaries.left, dx);
+        rightRhs = boundaryRhs(boundaries.right, dx);
+        bottomRhs = boundaryRhs(boundaries.bottom, dx);
+        topRhs = boundaryRhs(boundaries.top, dx);
+        stopped = false;
 
-                for (int i = 0; i < N; ++i) {
-                    temperatureGrids[t + 1][i][j] = d[i];
-                }
+        initializeFrames();
+
+        /** Histogram range: every temperature the edges or pure heating during tmax can impose */
+        double low = u0;
+        double high = u0 + tmax * source.maxValue() / (material.density * material.specificHeat);
+        for (const BoundaryCondition* edge : {&boundaries.left, &boundaries.right, &boundaries.bottom, &boundaries.top}) {
+            if (edge->type == BoundaryCondition::Type::Dirichlet) {
+                low = std::min(low, edge->value);
+                high = std::max(high, edge->value);
             }
+        }
+        FrameStats empty(low, high);
+        frameStats.assign(M, empty);
+        workerStats.assign(pool ? pool->size() : 1, empty);
+        rowSums.resize(N);
+        for (int i = 0; i < N; ++i) {
+            frameStats[0].accumulate(frame(0) + i * rowStride, N);
+        }
+
+        lastStep = 0;
+        emitSnapshot(0);
+        runControl.reportProgress(0, M - 1);
+    }
+
+    bool HeatEquationSolver2D::advance() {
+        if (lastStep >= M - 1 || stopped) {
+            return false;
+        }
+        const int t = lastStep;
+        const double* s = sourceTerm.data();
+        const double* current = frame(t);
+        double* next = frame(t + 1);
 
-            // Implicit solve along y-direction
-            for (int i = 0; i < N; ++i) {
-                for (int j = 1; j < N - 1; ++j) {
-                    d[j] = temperatureGrids[t + 1][i][j];
+        // Implicit solve along x-direction: blocks of adjacent lines j are solved together,
+        // in place in the next frame, so every access is a unit-stride row segment
+        forEachLine([&](int first, int last, int) {
+            HEAT_TRACE_SCOPE("x sweep");
+            for (int j0 = first; j0 < last; j0 += lineBlock) {
+                int width = last - j0 < lineBlock ? last - j0 : lineBlock;
+                {
+                    HEAT_METRIC_SCOPE(MetricPhase::RhsAssembly, 3 * sizeof(double) * N * width);
+                    for (int k = 0; k < width; ++k) {
+                        next[j0 + k] = leftRhs;
+                    }
+                    for (int i = 1; i < N - 1; ++i) {
+                        const double* __restrict src = current + i * rowStride + j0;
+                        const double* __restrict q = s + i * rowStride + j0;
+                        double* __restrict dst = next + i * rowStride + j0;
+                        for (int k = 0; k < width; ++k) {
+                            dst[k] = src[k] + q[k];
+                        }
+                    }
+                    for (int k = 0; k < width; ++k) {
+                        next[(N - 1) * rowStride + j0 + k] = rightRhs;
+                    }
                 }
-                applyDirichletBoundary(temperatureGrids[t + 1]);
-                solveTridiagonal(a.data(), b.data(), c.data(), d.data(), N);
+                HEAT_METRIC_SCOPE(MetricPhase::TridiagonalSolve, 2 * sizeof(double) * N * (width + 1));
+                xOperator.applyColumns(next + j0, rowStride, width);
+            }
+        }, lineBlock);
 
-                for (int j = 0; j < N; ++j) {
-                    temperatureGrids[t + 1][i][j] = d[j];
+        // Implicit solve along y-direction: each interior line i is a contiguous row, solved in place
+        forEachLine([&](int first, int last, int worker) {
+            HEAT_TRACE_SCOPE("y sweep");
+            /** One record per chunk (it includes the in-cache statistics pass of its rows) */
+            HEAT_METRIC_SCOPE(MetricPhase::TridiagonalSolve, 4 * sizeof(double) * N * (last - first));
+            for (int i = first; i < last; ++i) {
+                if (i == 0 || i == N - 1) {
+                    continue; /** Edge rows are fixed by the x conditions below */
                 }
+                double* line = next + i * rowStride;
+                line[0] = bottomRhs;
+                line[N - 1] = topRhs;
+                yOperator.apply(line);
+                rowSums[i] = workerStats[worker].accumulate(line, N); /** Line is still in cache */
             }
+        }, 8);
+        {
+            HEAT_TRACE_SCOPE("edges and stats");
+            closeEdgeRows(next);
+            finishFrameStats(t + 1, next);
         }
+
+        lastStep = t + 1;
+        emitSnapshot(lastStep);
+
+        /** Publish progress and honor cancellation every few steps */
+        if (lastStep % controlInterval == 0 || lastStep == M - 1) {
+            runControl.reportProgress(lastStep, M - 1);
+            stopped = runControl.cancelled();
+        }
+        return true;
     }
 
-    const std::vector<std::vector<std::vector<double>>>& HeatEquationSolver2D::getAllTemperatureGrids() const {
-        return temperatureGrids;
+    FieldView HeatEquationSolver2D::currentField() const {
+        return FieldView(frame(lastStep), N, N, rowStride);
+    }
+
+    void HeatEquationSolver2D::finishFrameStats(int timeStep, const double* grid) {
+        FrameStats& stats = frameStats[timeStep];
+        for (FrameStats& partial : workerStats) {
+            stats.merge(partial);
+            partial.reset();
+        }
+        rowSums[0] = stats.accumulate(grid, N);
+        rowSums[N - 1] = stats.accumulate(grid + (N - 1) * rowStride, N);
+
+        double sum = 0.0;
+        for (int i = 0; i < N; ++i) {
+            sum += rowSums[i];
+        }
+        stats.sum = sum;
+    }
+
+    FieldSequenceView HeatEquationSolver2D::getAllTemperatureGrids() const {
+        return FieldSequenceView(temperatureGrids.data(), storedFrames, N, N, rowStride, static_cast<std::ptrdiff_t>(frameStride));
+    }
+
+    FieldView HeatEquationSolver2D::getTemperatureAtTime(int timeStep) const {
+        if (timeStep < 0 || timeStep >= M) {
+            return FieldView();
+        }
+        if (storageMode == StorageMode::Rolling && (timeStep > lastStep || timeStep < lastStep - 1)) {
+            return FieldView(); /** No longer (or not yet) held in the two-frame buffer */
+        }
+        return FieldView(frame(timeStep), N, N, rowStride);
+    }
+
+    const FrameStats& HeatEquationSolver2D::getFrameStats(int timeStep) const {
+        static const FrameStats none;
+        if (timeStep < 0 || timeStep >= static_cast<int>(frameStats.size())) {
+            return none;
+        }
+        return frameStats[timeStep];
+    }
+
+    FrameStats HeatEquationSolver2D::getSummaryStats() const {
+        if (frameStats.empty()) {
+            return FrameStats();
+        }
+        FrameStats summary(frameStats[0].low, frameStats[0].high);
+        for (int t = 0; t <= lastStep; ++t) {
+            summary.merge(frameStats[t]);
+        }
+        return summary;
     }
 
 }
@@ -1,9 +1,19 @@
 #ifndef HEAT_EQUATION_SOLVER_2D_H
 #define HEAT_EQUATION_SOLVER_2D_H
 
+#include <memory>
 #include <vector>
+#include "AlignedBuffer.h"
+#include "BoundaryCondition.h"
+#include "FieldView.h"
+#include "FrameStats.h"
 #include "Material.h"
 #include "Heatsource2D.h"
+#include "RunControl.h"
+#include "Snapshot.h"
+#include "StepRange.h"
+#include "ThreadPool.h"
+#include "TridiagonalOperator.h"
 
 /**
  * @brief Solves the two-dimensional heat equation for a given material and heat source.
@@ -21,22 +31,79 @@ namespace heat {
         double dx;              /**< Spatial step size */
         double dt;              /**< Time step size */
 
-        std::vector<std::vector<std::vector<double>>> temperatureGrids; /**< 3D array for temperature values */
+        int rowStride;              /**< Distance between two grid rows (N padded to a cache line) */
+        std::size_t frameStride;    /**< Distance between two frames (N * rowStride) */
+        AlignedBuffer temperatureGrids; /**< All stored frames in one contiguous frame-major block */
+        StorageMode storageMode;    /**< Full history or rolling two-frame storage */
+        int storedFrames;           /**< Number of frames held in temperatureGrids */
+        SnapshotPolicy snapshotPolicy; /**< Time steps sent to the sink (rolling mode) */
+        FrameSink snapshotSink;     /**< Receiver of the snapshots (rolling mode) */
+        int lastStep;               /**< Index of the most recently computed time step */
+        BoundaryConditions2D boundaries;      /**< Conditions on the four edges of the plate */
+        TridiagonalOperator xOperator;        /**< Factored x-line matrix with the left/right conditions folded in */
+        TridiagonalOperator yOperator;        /**< Factored y-line matrix with the bottom/top conditions folded in */
+        AlignedBuffer sourceTerm;   /**< Cached dt * F(x, y) / (rho * c), laid out like one frame */
+        bool sourceCacheValid;      /**< Whether sourceTerm matches the current source */
+        double sourceCacheDt;       /**< Time step the cache was computed for */
+        RunControl runControl;      /**< Progress reporting and cancellation, checked every controlInterval steps */
+        static constexpr int controlInterval = 4; /**< Time steps between two progress/cancellation checks */
+        std::vector<FrameStats> frameStats;  /**< Statistics of every time step, filled while solving */
+        std::vector<FrameStats> workerStats; /**< Partial statistics of the current frame, one per thread */
+        std::vector<double> rowSums;         /**< Sum of each row of the current frame, for an ordered total */
+
+        std::unique_ptr<ThreadPool> pool;     /**< Threads running the line sweeps (null = serial) */
+        Partitioning linePartitioning;        /**< Distribution of the lines over the threads */
+
+        static constexpr int lineBlock = 32;  /**< x-lines solved together in SIMD lanes (4 cache lines per row) */
+        double leftRhs;             /**< Right-hand side of the x = 0 edge row (set by start()) */
+        double rightRhs;            /**< Right-hand side of the x = L edge row */
+        double bottomRhs;           /**< Right-hand side of the y = 0 edge column */
+        double topRhs;              /**< Right-hand side of the y = L edge column */
+        bool stopped;               /**< Set when the run was cancelled */
+
+        /**
+         * @brief Imposes the left/right conditions on the rows x = 0 and x = L of a frame.
+         *
+         * The y-sweep only solves the interior rows; this closes the two edge rows in O(N).
+         */
+        void closeEdgeRows(double* grid);
+
+        /**
+         * @brief Sizes the frame storage (allocating only if needed) and fills it with u0.
+         */
+        void initializeFrames();
+
+        /**
+         * @brief Returns the first value of the storage frame holding a given time step.
+         */
+        double* frame(int timeStep);
+        const double* frame(int timeStep) const;
+
+        /**
+         * @brief Sends a time step to the snapshot sink if the snapshot policy selects it.
+         */
+        void emitSnapshot(int timeStep) const;
 
         /**
-         * @brief Applies Neumann boundary condition at the left boundary (x = 0).
+         * @brief Completes the statistics of a frame from the per-thread partials of its interior rows.
+         *
+         * Extremes and histogram counts do not depend on the merge order; the sum is rebuilt
+         * from rowSums in row order so the mean is identical for every thread count.
          */
-        void applyNeumannBoundary(std::vector<std::vector<double>>& grid);
+        void finishFrameStats(int timeStep, const double* grid);
 
         /**
-         * @brief Applies Dirichlet boundary condition at the right boundary (x = L).
+         * @brief Materializes the scaled source term if the source or dt changed since the last solve.
          */
-        void applyDirichletBoundary(std::vector<std::vector<double>>& grid);
+        void updateSourceCache();
 
         /**
-         * @brief Solves a tridiagonal system of equations using the Thomas algorithm.
+         * @brief Runs body over the N lines of a sweep, in parallel if a thread pool is set.
+         *
+         * @param body Loop body receiving a range of lines and the worker index
+         * @param grain Number of lines handed out at once with dynamic partitioning
          */
-        void solveTridiagonal(double* a, double* b, double* c, double* d, int size);
+        void forEachLine(const ThreadPool::RangeTask& body, int grain);
 
     public:
         /**
@@ -44,15 +111,125 @@ namespace heat {
          */
         HeatEquationSolver2D(const Material& material, const Heatsource2D& source, double L, double tmax, double u0, int N, int M);
 
+        /**
+         * @brief Replace the heat source (invalidates the cached source term).
+         */
+        void setSource(const Heatsource2D& newSource);
+
+        /**
+         * @brief Set the conditions on the four edges of the plate.
+         *
+         * Defaults to an insulated edge (Neumann) at x = 0 and y = 0 and a fixed temperature
+         * u0 (Dirichlet) at x = L and y = L. The conditions are folded into the line operators,
+         * so no separate boundary pass is needed.
+         */
+        void setBoundaryConditions(const BoundaryConditions2D& conditions);
+
+        /**
+         * @brief Set the number of threads used by the x and y sweeps.
+         *
+         * Every line is solved with the same arithmetic whatever the thread count, so
+         * the result is bitwise identical to the serial solve.
+         *
+         * @param threads Total number of threads (1 = serial, 0 = hardware concurrency)
+         * @param partitioning Static blocks of lines or dynamic chunks of lines
+         */
+        void setThreadCount(int threads, Partitioning partitioning = Partitioning::Static);
+
+        /**
+         * @brief Keep every time step in memory (default).
+         */
+        void setFullStorage();
+
+        /**
+         * @brief Keep only the current and the next frame in memory.
+         *
+         * Memory no longer grows with M. The time steps selected by the policy are passed to
+         * the sink while they are computed, e.g. FrameRing::sink() or FrameFileWriter::sink().
+         *
+         * @param policy Time steps passed to the sink (step 0 and the last step always are)
+         * @param sink Receiver of the snapshots (may be empty)
+         */
+        void setRollingStorage(const SnapshotPolicy& policy, FrameSink sink);
+
+        /**
+         * @brief Share progress and cancellation with another thread.
+         *
+         * Every few time steps the solver publishes the number of steps done and stops early
+         * if the control was cancelled; the steps computed so far stay available.
+         */
+        void setRunControl(const RunControl& control) { runControl = control; }
+
+        /**
+         * @brief Index of the last time step computed (M - 1 after a complete solve).
+         */
+        int lastComputedStep() const { return lastStep; }
+
         /**
          * @brief Solve the 2D heat equation using finite difference methods.
+         *
+         * Equivalent to start() followed by advance() until it returns false.
          */
         void solve();
 
         /**
-         * @brief Returns the entire temperature grid for visualization.
+         * @brief Prepares a solve: initial frame, factored line operators, source term; step 0 is ready.
+         */
+        void start();
+
+        /**
+         * @brief Computes the next time step (one x-sweep and one y-sweep).
+         *
+         * @return false (and computes nothing) if the last step was already reached or the run was cancelled
+         */
+        bool advance();
+
+        /**
+         * @brief View of the most recently computed frame, valid until the next advance().
+         */
+        FieldView currentField() const;
+
+        /**
+         * @brief Lazy range computing one time step per iteration.
+         *
+         * Use with rolling storage to keep only two frames whatever the number of steps.
+         */
+        StepRange<HeatEquationSolver2D> steps() { return StepRange<HeatEquationSolver2D>(*this); }
+
+        /**
+         * @brief Returns a view of every stored temperature frame for visualization (no copy).
+         *
+         * Frame t, row i, column j is the temperature at (x = i * dx, y = j * dx) and time step t.
+         * In rolling mode the view holds the two storage frames, even time steps in frame 0 and
+         * odd time steps in frame 1.
+         */
+        FieldSequenceView getAllTemperatureGrids() const;
+
+        /**
+         * @brief Returns a view of the frame at a specific time step.
+         *
+         * @param timeStep The time step index (0 to M-1)
+         * @return The frame, or an empty view if it is out of range or no longer retained
+         */
+        FieldView getTemperatureAtTime(int timeStep) const;
+
+        /**
+         * @brief Returns the statistics of a time step.
+         *
+         * They are accumulated by the y-sweep while each line is in cache, in every storage
+         * mode, and are complete before the frame reaches the snapshot sink. The histogram
+         * spans the lowest to the highest of u0, the Dirichlet edge values and the temperature
+         * the source alone could reach in tmax.
+         *
+         * @param timeStep The time step index (0 to M-1)
+         * @return The statistics (count 0 if the step is out of range or not computed yet)
+         */
+        const FrameStats& getFrameStats(int timeStep) const;
+
+        /**
+         * @brief Returns the statistics of every time step computed so far, merged.
          */
-        const std::vector<std::vector<std::vector<double>>>& getAllTemperatureGrids() const;
+        FrameStats getSummaryStats() const;
 
     };
 }
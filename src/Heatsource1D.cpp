@@ -17,4 +17,8 @@ namespace heat{
             return 0.0;
         }
     }
+
+    double Heatsource1D::maxValue() const{
+        return t_max_ * f_ * f_; /** Region 1 is the strongest */
+    }
 }
\ No newline at end of file
@@ -29,6 +29,12 @@ namespace heat{
          * @return Heat source value F(x)
          */
         double F(double x) const;
+
+        /**
+         * @brief upper bound of the heat source over the bar
+         * @return Maximum value of F(x)
+         */
+        double maxValue() const;
     };
 
 }
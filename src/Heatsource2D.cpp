@@ -16,4 +16,8 @@ namespace heat {
         }
     }
 
+    double Heatsource2D::maxValue() const {
+        return t_max_ * f_ * f_; /** All four regions share the same intensity */
+    }
+
 }
@@ -30,6 +30,12 @@ namespace heat {
          * @return Heat source value F(x, y)
          */
         double F(double x, double y) const;
+
+        /**
+         * @brief Upper bound of the heat source over the domain
+         * @return Maximum value of F(x, y)
+         */
+        double maxValue() const;
     };
 
 }
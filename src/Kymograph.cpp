@@ -0,0 +1,58 @@
+#include "Kymograph.h"
+#include <algorithm>
+
+namespace heat {
+
+    Kymograph::Kymograph(int size, int timeSteps, double minTemperature, double maxTemperature, ColormapKind kind)
+        : size_(0), columns_(0), timeSteps_(0), rows_(0), minTemp_(0.0), maxTemp_(1.0), colormap_(kind), dirtyBegin_(0), dirtyEnd_(0) {
+        reset(size, timeSteps, minTemperature, maxTemperature);
+    }
+
+    void Kymograph::reset(int size, int timeSteps, double minTemperature, double maxTemperature) {
+        size_ = size;
+        columns_ = std::min(size, maxColumns);
+        timeSteps_ = timeSteps;
+        rows_ = std::min(timeSteps, maxRows);
+        minTemp_ = minTemperature;
+        maxTemp_ = maxTemperature;
+        pixels_.assign(static_cast<size_t>(std::max(0, columns_)) * std::max(0, rows_), 0xFF000000u);
+        dirtyBegin_ = 0;
+        dirtyEnd_ = rows_; /** Upload the black background on the first draw */
+    }
+
+    void Kymograph::appendRow(int timeStep, const double* temperature) {
+        if (timeStep < 0 || timeStep >= timeSteps_ || rows_ == 0) {
+            return;
+        }
+        int row = static_cast<int>(static_cast<long long>(timeStep) * rows_ / timeSteps_);
+        const double* profile = temperature;
+        if (columns_ < size_) {
+            profile = resampler_.resample(FieldView(temperature, 1, size_), 1, columns_, ResampleMode::Box).row(0);
+        }
+        colormap_.colorize(profile, columns_, minTemp_, maxTemp_, pixels_.data() + static_cast<size_t>(row) * columns_);
+        if (dirtyBegin_ >= dirtyEnd_) {
+            dirtyBegin_ = row;
+            dirtyEnd_ = row + 1;
+        } else {
+            dirtyBegin_ = std::min(dirtyBegin_, row);
+            dirtyEnd_ = std::max(dirtyEnd_, row + 1);
+        }
+    }
+
+    void Kymograph::appendAll(const FieldView& profiles) {
+        for (int t = 0; t < profiles.rows(); ++t) {
+            appendRow(t, profiles.row(t));
+        }
+    }
+
+    void Kymograph::draw(SDL_Renderer* renderer, StreamingTexture& texture, const SDL_Rect* destination) {
+        if (rows_ == 0 || columns_ <= 0) {
+            return;
+        }
+        if (texture.uploadRows(renderer, columns_, rows_, pixels_.data(), dirtyBegin_, dirtyEnd_ - dirtyBegin_)) {
+            dirtyBegin_ = dirtyEnd_ = 0;
+        }
+        texture.draw(renderer, destination);
+    }
+
+}
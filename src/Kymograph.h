@@ -0,0 +1,88 @@
+#ifndef KYMOGRAPH_H
+#define KYMOGRAPH_H
+
+#include <vector>
+#include <SDL2/SDL.h>
+#include "Colormap.h"
+#include "FieldResampler.h"
+#include "FieldView.h"
+#include "StreamingTexture.h"
+
+namespace heat {
+
+    /**
+     * @brief Space-time heatmap of a 1D run: x horizontal, time going down, one texture.
+     *
+     * The texture itself is supplied by the caller (typically a DisplaySession texture, so it
+     * survives from one run to the next). Rows are colorized once, when their time step is appended, and only the rows added
+     * since the last draw are uploaded, so the whole evolution costs one texture draw per
+     * frame instead of one render per time step. Runs longer than the texture height share
+     * rows: time step t lands in row t * rows / timeSteps and the latest step of a row wins.
+     * Profiles wider than the texture width limit are box-averaged down to it.
+     */
+    class Kymograph {
+    private:
+        int size_;         /**< Samples per profile */
+        int columns_;      /**< Texture width: size_ reduced to at most maxColumns */
+        int timeSteps_;    /**< Number of time steps of the run */
+        int rows_;         /**< Texture height */
+        double minTemp_;   /**< Temperature mapped to the coldest color */
+        double maxTemp_;   /**< Temperature mapped to the hottest color */
+        Colormap colormap_; /**< Temperature color scale */
+        std::vector<Uint32> pixels_; /**< Colorized rows, row-major */
+        int dirtyBegin_;   /**< First row not uploaded yet */
+        int dirtyEnd_;     /**< One past the last row not uploaded yet */
+        FieldResampler resampler_; /**< Reduces profiles wider than maxColumns */
+
+    public:
+        static constexpr int maxRows = 4096; /**< Texture height limit (within every renderer's texture size) */
+        static constexpr int maxColumns = 4096; /**< Texture width limit, for the same reason */
+
+        /**
+         * @brief Creates an empty (black) heatmap.
+         *
+         * @param size Samples per profile
+         * @param timeSteps Number of time steps of the run
+         * @param minTemperature Temperature mapped to the coldest color
+         * @param maxTemperature Temperature mapped to the hottest color
+         * @param kind Color scale
+         */
+        Kymograph(int size = 0, int timeSteps = 0, double minTemperature = 0.0, double maxTemperature = 1.0,
+                  ColormapKind kind = ColormapKind::GreenRed);
+
+        /**
+         * @brief Clears the heatmap for a new run.
+         */
+        void reset(int size, int timeSteps, double minTemperature, double maxTemperature);
+
+        /**
+         * @brief Selects the color scale of the rows appended afterwards.
+         */
+        void setColormap(ColormapKind kind) { colormap_ = Colormap(kind); }
+
+        /**
+         * @brief Colorizes the profile of one time step into its row.
+         */
+        void appendRow(int timeStep, const double* temperature);
+
+        /**
+         * @brief Colorizes every row of a stored run (row t of the view is time step t).
+         */
+        void appendAll(const FieldView& profiles);
+
+        /**
+         * @brief Uploads the rows appended since the last draw and draws the heatmap.
+         *
+         * After reset() the first draw uploads every row, so a texture used by a previous
+         * heatmap of the same size never shows stale rows.
+         *
+         * @param renderer Renderer owning the texture
+         * @param texture Texture holding the heatmap (always pass the same one between resets)
+         * @param destination Target rectangle (null = the whole render target)
+         */
+        void draw(SDL_Renderer* renderer, StreamingTexture& texture, const SDL_Rect* destination = nullptr);
+    };
+
+}
+
+#endif
@@ -0,0 +1,73 @@
+#include "Metrics.h"
+#include <fstream>
+#include <stdexcept>
+
+namespace heat {
+
+    Metrics& Metrics::global() {
+        static Metrics metrics;
+        return metrics;
+    }
+
+    const char* Metrics::name(MetricPhase phase) {
+        switch (phase) {
+            case MetricPhase::RhsAssembly: return "rhs_assembly";
+            case MetricPhase::SourceEvaluation: return "source_evaluation";
+            case MetricPhase::TridiagonalSolve: return "tridiagonal_solve";
+            case MetricPhase::RowCopy: return "row_copy";
+            case MetricPhase::Boundary: return "boundary";
+            case MetricPhase::Colorize: return "colorize";
+            case MetricPhase::TextureUpload: return "texture_upload";
+            case MetricPhase::Present: return "present";
+        }
+        return "unknown";
+    }
+
+    void Metrics::record(MetricPhase phase, std::uint64_t nanoseconds, std::uint64_t bytes) {
+        Counter& counter = counters_[static_cast<int>(phase)];
+        counter.nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+        counter.calls.fetch_add(1, std::memory_order_relaxed);
+        counter.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    MetricTotals Metrics::totals(MetricPhase phase) const {
+        const Counter& counter = counters_[static_cast<int>(phase)];
+        MetricTotals totals;
+        totals.nanoseconds = counter.nanoseconds.load(std::memory_order_relaxed);
+        totals.calls = counter.calls.load(std::memory_order_relaxed);
+        totals.bytes = counter.bytes.load(std::memory_order_relaxed);
+        return totals;
+    }
+
+    void Metrics::reset() {
+        for (Counter& counter : counters_) {
+            counter.nanoseconds.store(0, std::memory_order_relaxed);
+            counter.calls.store(0, std::memory_order_relaxed);
+            counter.bytes.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void Metrics::writeJson(std::ostream& os) const {
+        os << "{\n  \"enabled\": " << (enabled ? "true" : "false") << ",\n  \"phases\": {";
+        for (int k = 0; k < metricPhaseCount; ++k) {
+            MetricPhase phase = static_cast<MetricPhase>(k);
+            MetricTotals t = totals(phase);
+            os << (k == 0 ? "\n" : ",\n")
+               << "    \"" << name(phase) << "\": {\"nanoseconds\": " << t.nanoseconds
+               << ", \"calls\": " << t.calls << ", \"bytes\": " << t.bytes << "}";
+        }
+        os << "\n  }\n}\n";
+    }
+
+    void Metrics::writeJson(const std::string& path) const {
+        std::ofstream file(path);
+        if (!file) {
+            throw std::runtime_error("Cannot open metrics file " + path);
+        }
+        writeJson(file);
+        if (!file) {
+            throw std::runtime_error("Cannot write metrics file " + path);
+        }
+    }
+
+}
@@ -0,0 +1,147 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace heat {
+
+    /**
+     * @brief Hot-path phases timed by the metric scopes.
+     */
+    enum class MetricPhase {
+        RhsAssembly,       /**< Building the right-hand side of the implicit systems */
+        SourceEvaluation,  /**< Calls to the heat source F (cached once per solve) */
+        TridiagonalSolve,  /**< Forward and back substitution of the prefactored systems */
+        RowCopy,           /**< Copies of solved rows into the temperature storage */
+        Boundary,          /**< Boundary condition passes */
+        Colorize,          /**< Temperature-to-color conversion */
+        TextureUpload,     /**< Pixel uploads to the streaming textures */
+        Present            /**< SDL_RenderPresent (includes the wait for vsync) */
+    };
+
+    /** Number of MetricPhase values */
+    constexpr int metricPhaseCount = 8;
+
+    /**
+     * @brief Accumulated cost of one phase.
+     */
+    struct MetricTotals {
+        std::uint64_t nanoseconds; /**< Wall time spent in the phase */
+        std::uint64_t calls;       /**< Number of timed scopes */
+        std::uint64_t bytes;       /**< Bytes read and written, as estimated by each scope */
+    };
+
+    /**
+     * @brief Process-wide time, call and byte counters per hot-path phase.
+     *
+     * Filled by HEAT_METRIC_SCOPE, which only exists when the program is compiled with
+     * -DHEAT_ENABLE_METRICS; otherwise the scopes compile to nothing and every counter
+     * stays at zero. Counters are relaxed atomics on separate cache lines, so solver
+     * worker threads may record concurrently.
+     */
+    class Metrics {
+    private:
+        /** One phase; aligned so that phases recorded by different threads do not share a line */
+        struct alignas(64) Counter {
+            std::atomic<std::uint64_t> nanoseconds{0};
+            std::atomic<std::uint64_t> calls{0};
+            std::atomic<std::uint64_t> bytes{0};
+        };
+
+        Counter counters_[metricPhaseCount]; /**< Indexed by MetricPhase */
+
+    public:
+#ifdef HEAT_ENABLE_METRICS
+        static constexpr bool enabled = true;  /**< The scopes are compiled in */
+#else
+        static constexpr bool enabled = false; /**< The scopes are compiled out */
+#endif
+
+        /**
+         * @brief The counters every scope records into.
+         */
+        static Metrics& global();
+
+        /**
+         * @brief Name of a phase as written in the JSON dump (e.g. "tridiagonal_solve").
+         */
+        static const char* name(MetricPhase phase);
+
+        /**
+         * @brief Adds one timed call to a phase.
+         *
+         * @param phase : The phase
+         * @param nanoseconds : Time spent
+         * @param bytes : Bytes moved by the call
+         */
+        void record(MetricPhase phase, std::uint64_t nanoseconds, std::uint64_t bytes);
+
+        /**
+         * @brief Totals of a phase so far.
+         */
+        MetricTotals totals(MetricPhase phase) const;
+
+        /**
+         * @brief Sets every counter back to zero.
+         */
+        void reset();
+
+        /**
+         * @brief Writes the totals of every phase as a JSON object.
+         *
+         * @param os : The output stream
+         */
+        void writeJson(std::ostream& os) const;
+
+        /**
+         * @brief Writes the JSON dump to a file.
+         *
+         * @param path : Output file
+         * @throws std::runtime_error if the file cannot be written
+         */
+        void writeJson(const std::string& path) const;
+    };
+
+    /**
+     * @brief Times the enclosing block and records it in Metrics::global() on exit.
+     *
+     * Use through HEAT_METRIC_SCOPE so that it disappears from builds without metrics.
+     */
+    class MetricScope {
+    private:
+        MetricPhase phase_;                                /**< Phase credited */
+        std::uint64_t bytes_;                              /**< Bytes moved by the block */
+        std::chrono::steady_clock::time_point start_;      /**< Entry time */
+
+    public:
+        MetricScope(MetricPhase phase, std::uint64_t bytes) : phase_(phase), bytes_(bytes), start_(std::chrono::steady_clock::now()) {}
+
+        ~MetricScope() {
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_);
+            Metrics::global().record(phase_, static_cast<std::uint64_t>(elapsed.count()), bytes_);
+        }
+
+        MetricScope(const MetricScope&) = delete;
+        MetricScope& operator=(const MetricScope&) = delete;
+    };
+
+}
+
+/**
+ * HEAT_METRIC_SCOPE(phase, bytes) times the rest of the enclosing block. Without
+ * HEAT_ENABLE_METRICS it expands to nothing and its arguments are not evaluated.
+ */
+#ifdef HEAT_ENABLE_METRICS
+#define HEAT_METRIC_CONCAT_(a, b) a##b
+#define HEAT_METRIC_CONCAT(a, b) HEAT_METRIC_CONCAT_(a, b)
+#define HEAT_METRIC_SCOPE(phase, bytes) \
+    ::heat::MetricScope HEAT_METRIC_CONCAT(metricScope_, __LINE__)((phase), static_cast<std::uint64_t>(bytes))
+#else
+#define HEAT_METRIC_SCOPE(phase, bytes) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,158 @@
+#include "PlaybackController.h"
+#include <algorithm>
+#include <cmath>
+
+namespace heat {
+
+    PlaybackController::PlaybackController(double targetFps, int frameCount)
+        : targetFps_(targetFps > 0.0 ? targetFps : 10.0), speed_(1.0), paused_(false), quit_(false), redraw_(false),
+          frameCount_(frameCount), lastShown_(-1), skipped_(0), position_(0.0), lastTick_(0) {}
+
+    void PlaybackController::start(int frameCount) {
+        frameCount_ = frameCount;
+        lastShown_ = -1;
+        skipped_ = 0;
+        position_ = 0.0;
+        quit_ = false;
+        redraw_ = false;
+        lastTick_ = SDL_GetPerformanceCounter();
+    }
+
+    void PlaybackController::setTargetFps(double fps) {
+        if (fps > 0.0) {
+            advanceClock();
+            targetFps_ = fps;
+        }
+    }
+
+    void PlaybackController::setSpeed(double speed) {
+        advanceClock();
+        speed_ = std::min(64.0, std::max(1.0 / 64.0, speed));
+    }
+
+    void PlaybackController::setPaused(bool paused) {
+        advanceClock();
+        paused_ = paused;
+    }
+
+    void PlaybackController::seek(int frame) {
+        if (frameCount_ <= 0) {
+            return;
+        }
+        position_ = std::min(frameCount_ - 1, std::max(0, frame));
+        redraw_ = true;
+    }
+
+    void PlaybackController::advanceClock() {
+        Uint64 now = SDL_GetPerformanceCounter();
+        if (lastTick_ == 0) {
+            lastTick_ = now;
+        }
+        if (!paused_) {
+            double seconds = static_cast<double>(now - lastTick_) / SDL_GetPerformanceFrequency();
+            position_ += seconds * targetFps_ * speed_;
+        }
+        lastTick_ = now;
+    }
+
+    int PlaybackController::millisecondsUntil(double frame) const {
+        if (position_ >= frame) {
+            return 0;
+        }
+        return static_cast<int>(std::ceil((frame - position_) * 1000.0 / (targetFps_ * speed_)));
+    }
+
+    void PlaybackController::handleEvent(const SDL_Event& event) {
+        if (event.type == SDL_QUIT) {
+            quit_ = true;
+            return;
+        }
+        if (event.type != SDL_KEYDOWN) {
+            return;
+        }
+        int step = (event.key.keysym.mod & KMOD_SHIFT) ? 10 : 1;
+        int current = lastShown_ < 0 ? 0 : lastShown_;
+        switch (event.key.keysym.sym) {
+        case SDLK_ESCAPE: quit_ = true; break;
+        case SDLK_SPACE:  setPaused(!paused_); break;
+        case SDLK_RIGHT:  seek(current + step); break;
+        case SDLK_LEFT:   seek(current - step); break;
+        case SDLK_UP:     setSpeed(speed_ * 2.0); break;
+        case SDLK_DOWN:   setSpeed(speed_ / 2.0); break;
+        case SDLK_HOME:   seek(0); break;
+        case SDLK_END:    seek(frameCount_ - 1); break;
+        default: break;
+        }
+    }
+
+    void PlaybackController::waitEvents(int timeoutMs) {
+        SDL_Event event;
+        if (SDL_WaitEventTimeout(&event, std::max(1, timeoutMs))) {
+            handleEvent(event);
+            while (SDL_PollEvent(&event)) {
+                handleEvent(event);
+            }
+        }
+    }
+
+    void PlaybackController::pollEvents() {
+        SDL_Event event;
+        while (SDL_PollEvent(&event)) {
+            handleEvent(event);
+        }
+    }
+
+    void PlaybackController::idle(int milliseconds) {
+        Uint32 end = SDL_GetTicks() + static_cast<Uint32>(milliseconds);
+        for (Uint32 now = SDL_GetTicks(); !quit_ && now < end; now = SDL_GetTicks()) {
+            waitEvents(static_cast<int>(end - now));
+        }
+    }
+
+    int PlaybackController::nextFrame() {
+        if (lastTick_ == 0) {
+            start(frameCount_);
+        }
+        while (!quit_ && frameCount_ > 0) {
+            advanceClock();
+            int due = std::min(frameCount_ - 1, static_cast<int>(position_));
+            if (due != lastShown_ || redraw_) {
+                if (due > lastShown_ + 1 && !redraw_) {
+                    skipped_ += due - lastShown_ - 1;
+                }
+                lastShown_ = due;
+                redraw_ = false;
+                return due;
+            }
+            if (!paused_ && position_ >= frameCount_) {
+                return -1; /** The last frame has been on screen for one period */
+            }
+            // Idle until the next frame is due; paused playback only wakes up for input
+            waitEvents(paused_ ? 250 : millisecondsUntil(std::floor(position_) + 1.0));
+        }
+        return -1;
+    }
+
+    bool PlaybackController::waitFor(int frame, bool newerAvailable) {
+        if (lastTick_ == 0) {
+            start(frameCount_);
+            position_ = frame;
+        }
+        pollEvents();
+        advanceClock();
+        if (newerAvailable && position_ >= frame + 1) {
+            ++skipped_;
+            return false;
+        }
+        while (!quit_ && (paused_ || position_ < frame)) {
+            waitEvents(paused_ ? 250 : millisecondsUntil(frame));
+            advanceClock();
+        }
+        if (position_ >= frame + 1) {
+            position_ = frame; /** Late but nothing newer: resynchronize instead of skipping what follows */
+        }
+        lastShown_ = frame;
+        return !quit_;
+    }
+
+}
@@ -0,0 +1,122 @@
+#ifndef PLAYBACK_CONTROLLER_H
+#define PLAYBACK_CONTROLLER_H
+
+#include <SDL2/SDL.h>
+
+namespace heat {
+
+    /**
+     * @brief Paces an animation against the wall clock and handles the viewer controls.
+     *
+     * The playback position advances by targetFps * speed frames per second of wall time,
+     * so a run of F frames plays in F / (targetFps * speed) seconds whatever the rendering
+     * cost: frames whose time has passed are skipped. Between frames the controller sleeps
+     * in SDL_WaitEventTimeout, so an idle or paused viewer uses no CPU and still reacts to
+     * input immediately.
+     *
+     * Keys: Space pause/resume, Left/Right step one frame (ten with Shift), Up/Down double or
+     * halve the speed, Home/End jump to the first/last frame, Escape or closing the window quits.
+     */
+    class PlaybackController {
+    private:
+        double targetFps_;   /**< Frames per second at speed 1 */
+        double speed_;       /**< Playback speed multiplier */
+        bool paused_;        /**< Whether the position is frozen */
+        bool quit_;          /**< Whether the viewer asked to stop */
+        bool redraw_;        /**< Whether the current frame must be shown again (seek, resume) */
+        int frameCount_;     /**< Number of frames of the animation */
+        int lastShown_;      /**< Index of the last frame returned (-1 = none yet) */
+        int skipped_;        /**< Frames skipped because playback was behind */
+        double position_;    /**< Playback position in frames */
+        Uint64 lastTick_;    /**< Performance counter at the last clock update */
+
+        /**
+         * @brief Advances the position by the wall time elapsed since the last call.
+         */
+        void advanceClock();
+
+        /**
+         * @brief Sleeps until an event arrives or the timeout expires, then handles all pending events.
+         *
+         * @param timeoutMs Longest time to sleep in milliseconds
+         */
+        void waitEvents(int timeoutMs);
+
+        /**
+         * @brief Milliseconds until the position reaches a given frame (0 if it already has).
+         */
+        int millisecondsUntil(double frame) const;
+
+    public:
+        /**
+         * @brief Creates a controller.
+         *
+         * @param targetFps Frames shown per second at speed 1
+         * @param frameCount Number of frames of the animation (0 if unknown, e.g. live frames)
+         */
+        explicit PlaybackController(double targetFps = 10.0, int frameCount = 0);
+
+        /**
+         * @brief Restarts playback from frame 0 with a new number of frames.
+         */
+        void start(int frameCount);
+
+        void setTargetFps(double fps);
+        void setSpeed(double speed);
+        void setPaused(bool paused);
+
+        /**
+         * @brief Moves the position to a frame (clamped to the animation; random access mode only).
+         */
+        void seek(int frame);
+
+        /**
+         * @brief Applies one SDL event to the playback state.
+         */
+        void handleEvent(const SDL_Event& event);
+
+        /**
+         * @brief Random access mode: waits until a different frame is due and returns it.
+         *
+         * Frames that became due while the previous one was drawn are skipped.
+         *
+         * @return Index of the frame to draw, or -1 once the last frame has been shown for
+         *         one frame period or the viewer quit
+         */
+        int nextFrame();
+
+        /**
+         * @brief Streaming mode: paces frames that arrive one by one (e.g. from a running solver).
+         *
+         * Waits until the frame is due. A frame that is already late is skipped if a newer
+         * one is waiting; otherwise it is shown and the clock is resynchronized to it, so a
+         * slow producer never causes later frames to be skipped. Seeking is not available
+         * because past frames are no longer held.
+         *
+         * @param frame Index of the frame (time step)
+         * @param newerAvailable Whether another frame is already waiting behind this one
+         * @return true to draw the frame, false to skip it (check quit() as well)
+         */
+        bool waitFor(int frame, bool newerAvailable);
+
+        /**
+         * @brief Handles the pending events without waiting.
+         */
+        void pollEvents();
+
+        /**
+         * @brief Sleeps for a while, reacting to input, e.g. to leave a still image on screen.
+         *
+         * @param milliseconds How long to wait (returns early if the viewer quits)
+         */
+        void idle(int milliseconds);
+
+        bool quit() const { return quit_; }
+        bool paused() const { return paused_; }
+        double speed() const { return speed_; }
+        int skippedFrames() const { return skipped_; }
+    };
+
+}
+
+#endif
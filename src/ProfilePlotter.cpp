@@ -0,0 +1,116 @@
+#include "ProfilePlotter.h"
+#include <cmath>
+
+namespace heat {
+
+    namespace {
+
+        SDL_Color unpack(std::uint32_t argb) {
+            SDL_Color color;
+            color.a = static_cast<Uint8>(argb >> 24);
+            color.r = static_cast<Uint8>(argb >> 16);
+            color.g = static_cast<Uint8>(argb >> 8);
+            color.b = static_cast<Uint8>(argb);
+            return color;
+        }
+
+    }
+
+    ProfilePlotter::ProfilePlotter(int width, int height, float thickness)
+        : width_(width), height_(height), thickness_(thickness) {}
+
+    void ProfilePlotter::resize(int width, int height) {
+        width_ = width;
+        height_ = height;
+    }
+
+    void ProfilePlotter::clear() {
+        vertices_.clear();
+        indices_.clear();
+    }
+
+    void ProfilePlotter::decimate(const double* values, int count) {
+        samples_.clear();
+        if (count <= 2 * width_) {
+            for (int i = 0; i < count; ++i) {
+                samples_.push_back(i);
+            }
+            return;
+        }
+
+        // Keep the extremes of each pixel column, in their original order
+        for (int c = 0; c < width_; ++c) {
+            int first = static_cast<int>(static_cast<long long>(c) * count / width_);
+            int last = static_cast<int>(static_cast<long long>(c + 1) * count / width_);
+            int low = first;
+            int high = first;
+            for (int i = first + 1; i < last; ++i) {
+                if (values[i] < values[low]) low = i;
+                if (values[i] > values[high]) high = i;
+            }
+            if (low == high) {
+                samples_.push_back(low);
+            } else {
+                samples_.push_back(low < high ? low : high);
+                samples_.push_back(low < high ? high : low);
+            }
+        }
+    }
+
+    void ProfilePlotter::appendPolyline(const double* values, int count, double minValue, double maxValue,
+                                        const Colormap* colormap, std::uint32_t solid) {
+        if (count < 2) {
+            return;
+        }
+        decimate(values, count);
+
+        double range = maxValue - minValue;
+        double yScale = range > 0.0 ? height_ / range : 0.0;
+        double colorScale = range > 0.0 ? 1.0 / range : 0.0;
+        float half = thickness_ * 0.5f;
+
+        for (std::size_t k = 0; k + 1 < samples_.size(); ++k) {
+            int i0 = samples_[k];
+            int i1 = samples_[k + 1];
+            float x0 = static_cast<float>(static_cast<double>(i0) * width_ / count);
+            float x1 = static_cast<float>(static_cast<double>(i1) * width_ / count);
+            float y0 = static_cast<float>(height_ - (values[i0] - minValue) * yScale);
+            float y1 = static_cast<float>(height_ - (values[i1] - minValue) * yScale);
+
+            // Offset both ends along the segment normal to get a quad of the line thickness
+            float dx = x1 - x0;
+            float dy = y1 - y0;
+            float length = std::sqrt(dx * dx + dy * dy);
+            float nx = length > 0.0f ? -dy / length * half : 0.0f;
+            float ny = length > 0.0f ? dx / length * half : half;
+
+            SDL_Color c0 = unpack(colormap ? colormap->color((values[i0] - minValue) * colorScale) : solid);
+            SDL_Color c1 = unpack(colormap ? colormap->color((values[i1] - minValue) * colorScale) : solid);
+
+            int base = static_cast<int>(vertices_.size());
+            vertices_.push_back(SDL_Vertex{SDL_FPoint{x0 + nx, y0 + ny}, c0, SDL_FPoint{0.0f, 0.0f}});
+            vertices_.push_back(SDL_Vertex{SDL_FPoint{x0 - nx, y0 - ny}, c0, SDL_FPoint{0.0f, 0.0f}});
+            vertices_.push_back(SDL_Vertex{SDL_FPoint{x1 + nx, y1 + ny}, c1, SDL_FPoint{0.0f, 0.0f}});
+            vertices_.push_back(SDL_Vertex{SDL_FPoint{x1 - nx, y1 - ny}, c1, SDL_FPoint{0.0f, 0.0f}});
+            int quad[6] = {base, base + 1, base + 2, base + 1, base + 3, base + 2};
+            indices_.insert(indices_.end(), quad, quad + 6);
+        }
+    }
+
+    void ProfilePlotter::addProfile(const double* values, int count, double minValue, double maxValue, const Colormap& colormap) {
+        appendPolyline(values, count, minValue, maxValue, &colormap, 0);
+    }
+
+    void ProfilePlotter::addProfile(const double* values, int count, double minValue, double maxValue, std::uint32_t color) {
+        appendPolyline(values, count, minValue, maxValue, nullptr, color);
+    }
+
+    void ProfilePlotter::draw(SDL_Renderer* renderer) const {
+        if (vertices_.empty()) {
+            return;
+        }
+        SDL_RenderGeometry(renderer, nullptr, vertices_.data(), static_cast<int>(vertices_.size()),
+                           indices_.data(), static_cast<int>(indices_.size()));
+    }
+
+}
@@ -0,0 +1,96 @@
+#ifndef PROFILE_PLOTTER_H
+#define PROFILE_PLOTTER_H
+
+#include <cstdint>
+#include <vector>
+#include <SDL2/SDL.h>
+#include "Colormap.h"
+
+namespace heat {
+
+    /**
+     * @brief Draws 1D temperature profiles as polylines in a single SDL_RenderGeometry call.
+     *
+     * Each segment becomes a thin quad (two triangles) carrying the colors of its end points,
+     * so the whole plot, overlays included, is one vertex array and one draw call instead of
+     * one color change and one line call per segment. Profiles with more samples than the
+     * plot has pixel columns are decimated to the minimum and maximum of each column, which
+     * keeps the drawn envelope identical to the full-resolution curve.
+     */
+    class ProfilePlotter {
+    private:
+        int width_;                      /**< Plot width in pixels */
+        int height_;                     /**< Plot height in pixels */
+        float thickness_;                /**< Line thickness in pixels */
+        std::vector<SDL_Vertex> vertices_; /**< Quads of every profile added since clear() */
+        std::vector<int> indices_;       /**< Two triangles per quad */
+        std::vector<int> samples_;       /**< Sample indices kept for the current profile */
+
+        /**
+         * @brief Fills samples_ with the indices to draw (all of them, or min/max per pixel column).
+         */
+        void decimate(const double* values, int count);
+
+        /**
+         * @brief Appends the quads of the current samples_.
+         *
+         * @param colormap Color scale of the vertices, or null to draw every vertex in solid
+         */
+        void appendPolyline(const double* values, int count, double minValue, double maxValue,
+                            const Colormap* colormap, std::uint32_t solid);
+
+    public:
+        /**
+         * @brief Creates a plotter for an area of the render target.
+         *
+         * @param width Plot width in pixels
+         * @param height Plot height in pixels
+         * @param thickness Line thickness in pixels
+         */
+        ProfilePlotter(int width, int height, float thickness = 1.5f);
+
+        /**
+         * @brief Changes the plot size (takes effect for profiles added afterwards).
+         */
+        void resize(int width, int height);
+
+        /**
+         * @brief Removes every profile (keeps the allocated arrays).
+         */
+        void clear();
+
+        /**
+         * @brief Adds a profile colored by temperature, one color per vertex.
+         *
+         * Sample i is drawn at x = i * width / count; minValue maps to the bottom of the plot and
+         * maxValue to the top.
+         *
+         * @param values Temperature profile
+         * @param count Number of samples
+         * @param minValue Value at the bottom of the plot (and first color)
+         * @param maxValue Value at the top of the plot (and last color)
+         * @param colormap Color scale of the vertices
+         */
+        void addProfile(const double* values, int count, double minValue, double maxValue, const Colormap& colormap);
+
+        /**
+         * @brief Adds a profile in one color, e.g. to tell time steps or materials apart in an overlay.
+         *
+         * @param color Packed ARGB color (0xAARRGGBB)
+         */
+        void addProfile(const double* values, int count, double minValue, double maxValue, std::uint32_t color);
+
+        /**
+         * @brief Draws every profile added since clear() with one SDL_RenderGeometry call.
+         */
+        void draw(SDL_Renderer* renderer) const;
+
+        /**
+         * @brief Number of vertices of the current plot.
+         */
+        int vertexCount() const { return static_cast<int>(vertices_.size()); }
+    };
+
+}
+
+#endif
@@ -1,4 +1,12 @@
 #include "Result1D.h"
+#include <algorithm>
+#include <exception>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include "FrameQueue.h"
+#include "Tracer.h"
 
 namespace heat {
 
@@ -9,25 +17,184 @@ namespace heat {
         // Initialize the HeatEquationSolver1D with the provided parameters
         HeatEquationSolver1D solver(material_, heatSource, L_, t_max_, u0_, N_, M_);
 
-        // Solve the heat equation using the finite difference method
-        solver.solve();
+        if (headless_) {
+            // Write the whole evolution as one space-time image (x horizontal, time vertical)
+            solver.solve();
+            double maxTemperature = u0_ + t_max_ * heatSource.maxValue() / (material_.density * material_.specificHeat);
+            FrameExporter exporter(exportPrefix_, exportFormat_, ColormapKind::GreenRed, u0_, maxTemperature, 1);
+            exporter.submit(solver.getTemperatureField());
+            exporter.finish();
+            return;
+        }
+
+        // Initialize the Visualization object for rendering the results (in the shared window if there is one)
+        std::unique_ptr<Visualization> ownedVisualizer(display_ ? new Visualization(*display_, "1D Heat Equation Visualization")
+                                                                : new Visualization("1D Heat Equation Visualization"));
+        Visualization& visualizer = *ownedVisualizer;
+
+        // Solve on a second thread with two rolling rows; each profile is handed over through a small frame ring
+        FrameQueue queue(framesInFlight, 1, N_);
+        solver.setRollingStorage(SnapshotPolicy::every(1), [&queue](int timeStep, const double* temperature, int size) {
+            queue.push(timeStep, FieldView(temperature, 1, size));
+        });
 
-        // Initialize the Visualization object for rendering the results
-        Visualization visualizer("1D Heat Equation Visualization");
+        RunControl control;  /**< Lets the render loop stop the solver when the window is closed */
+        solver.setRunControl(control);
 
-        // Create a static array to hold the temperature profiles for each time step
-        const double* temperatureProfiles[M_];  /**< Holds temperature profiles at different time steps */
+        std::exception_ptr solverError;
+        std::thread solverThread([&]() {
+            Tracer::global().nameThread("solver");
+            try {
+                // Solve the heat equation using the finite difference method
+                solver.solve();
+            } catch (...) {
+                solverError = std::current_exception();
+            }
+            queue.close();
+        });
 
-        // Extract the temperature profile at each time step from the solver
-        for (int t = 0; t < M_; ++t) {
-            temperatureProfiles[t] = solver.getTemperatureAtTime(t);  /**< Access the temperature profile at time step t */
+        // Render the temperature profiles as they arrive
+        FieldView profile;
+        int timeStep = 0;
+        double maxTemperature = u0_;  /**< Maximum temperature for color scaling in visualization */
+        PlaybackController& playback = visualizer.playbackController();
+        playback.start(M_);
+        try {
+            if (kymograph_) {
+                // Rows are colorized once, so the scale must be fixed up front: u0 to the reachable bound
+                double bound = u0_ + t_max_ * heatSource.maxValue() / (material_.density * material_.specificHeat);
+                visualizer.beginKymograph(N_, M_, u0_, bound);
+                Uint32 lastRefresh = SDL_GetTicks();
+                while (queue.waitFront(profile, timeStep)) {
+                    visualizer.appendKymographRow(timeStep, profile.row(0));
+                    queue.release();
+                    playback.pollEvents();
+                    if (playback.quit()) {
+                        control.cancel();
+                        queue.cancel(); /**< Window closed: stop the solver and discard the remaining profiles */
+                        break;
+                    }
+                    if (SDL_GetTicks() - lastRefresh >= static_cast<Uint32>(kymographRefreshMs)) {
+                        visualizer.renderKymograph();
+                        lastRefresh = SDL_GetTicks();
+                    }
+                }
+                visualizer.renderKymograph();
+                playback.idle(2000); /**< Leave the finished heatmap on screen for a moment */
+            } else {
+                while (queue.waitFront(profile, timeStep)) {
+                    // Scale colors to the hottest temperature seen so far, recorded by the solver for each step
+                    maxTemperature = std::max(maxTemperature, solver.getFrameStats(timeStep).max);
+                    // Paced by the playback controller; late profiles are skipped if a newer one is waiting
+                    if (playback.waitFor(timeStep, queue.size() > 1)) {
+                        visualizer.render2DTemperatureProfile(profile.row(0), profile.cols(), maxTemperature);
+                    }
+                    queue.release();
+                    if (playback.quit()) {
+                        control.cancel();
+                        queue.cancel(); /**< Window closed: stop the solver and discard the remaining profiles */
+                        break;
+                    }
+                }
+            }
+        } catch (...) {
+            control.cancel();
+            queue.cancel();
+            solverThread.join();
+            throw;
         }
+        solverThread.join();
+
+        if (solverError) {
+            std::rethrow_exception(solverError);
+        }
+    }
 
-        // Compute the maximum temperature for color scaling (using initial temperature as a placeholder)
-        double maxTemperature = 700;  /**< Maximum temperature for color scaling in visualization */
+    RunHandle<HeatEquationSolver1D> Result1D::solveAsync(RunCallback<HeatEquationSolver1D> onComplete) const {
+        return solveAsync(SnapshotPolicy::every(1), nullptr, std::move(onComplete));
+    }
+
+    RunHandle<HeatEquationSolver1D> Result1D::solveAsync(const SnapshotPolicy& snapshots, SnapshotSink sink,
+                                                         RunCallback<HeatEquationSolver1D> onComplete) const {
+        RunControl control;
+        // Everything is captured by value: the run may outlive this object
+        double f = f_, tmax = t_max_, L = L_, u0 = u0_;
+        int N = N_, M = M_;
+        Material material = material_;
+        std::shared_future<std::shared_ptr<HeatEquationSolver1D>> result = std::async(std::launch::async, [=]() {
+            std::shared_ptr<HeatEquationSolver1D> solver;
+            std::exception_ptr error;
+            try {
+                Heatsource1D heatSource(tmax, L, f);
+                solver = std::make_shared<HeatEquationSolver1D>(material, heatSource, L, tmax, u0, N, M);
+                solver->setRunControl(control);
+                if (sink) {
+                    solver->setRollingStorage(snapshots, sink);
+                }
+                solver->solve();
+            } catch (...) {
+                error = std::current_exception();
+            }
+            notifyRunComplete(onComplete, solver.get(), error);
+            if (error) {
+                std::rethrow_exception(error);
+            }
+            return solver;
+        }).share();
+        return RunHandle<HeatEquationSolver1D>(result, control);
+    }
+
+    void Result1D::showResult(const HeatEquationSolver1D& solver) {
+        // Only the steps actually computed (all of them unless the run was cancelled)
+        FieldView field = solver.getTemperatureField();
+        if (field.rows() < solver.lastComputedStep() + 1) {
+            throw std::runtime_error("The run kept only its last two steps: show the frame ring it filled instead");
+        }
+
+        std::unique_ptr<Visualization> ownedVisualizer(display_ ? new Visualization(*display_, "1D Heat Equation Visualization")
+                                                                : new Visualization("1D Heat Equation Visualization"));
+        Visualization& visualizer = *ownedVisualizer;
+
+        FieldView computed(field.data(), solver.lastComputedStep() + 1, field.cols(), field.rowStride());
+        FrameStats stats = solver.getSummaryStats();
+
+        if (kymograph_) {
+            visualizer.renderKymograph(computed, stats.low, stats.high);
+            visualizer.playbackController().idle(2000); /**< Leave the heatmap on screen for a moment */
+        } else {
+            visualizer.renderMultiple2DTemperatureProfiles(computed, stats.max);
+        }
+    }
+
+    void Result1D::showResult(const HeatEquationSolver1D& solver, const FrameRing& frames) {
+        std::unique_ptr<Visualization> ownedVisualizer(display_ ? new Visualization(*display_, "1D Heat Equation Visualization")
+                                                                : new Visualization("1D Heat Equation Visualization"));
+        Visualization& visualizer = *ownedVisualizer;
+
+        // Statistics cover every computed step, not only the kept ones
+        FrameStats stats = solver.getSummaryStats();
+
+        if (kymograph_) {
+            // Each kept profile goes to the row of its time step
+            visualizer.beginKymograph(N_, M_, stats.low, stats.high);
+            for (int k = 0; k < frames.size(); ++k) {
+                visualizer.appendKymographRow(frames.timeStep(k), frames.frame(k).row(0));
+            }
+            visualizer.renderKymograph();
+            visualizer.playbackController().idle(2000); /**< Leave the heatmap on screen for a moment */
+        } else {
+            PlaybackController& playback = visualizer.playbackController();
+            playback.start(frames.size());
+            for (int k = playback.nextFrame(); k >= 0; k = playback.nextFrame()) {
+                visualizer.render2DTemperatureProfile(frames.frame(k).row(0), N_, stats.max);
+            }
+        }
+    }
 
-        // Render the temperature profiles at all time steps
-        visualizer.renderMultiple2DTemperatureProfiles(temperatureProfiles, M_, N_, maxTemperature);
+    void Result1D::setHeadlessExport(const std::string& pathPrefix, ExportFormat format) {
+        headless_ = true;
+        exportPrefix_ = pathPrefix;
+        exportFormat_ = format;
     }
 
 }
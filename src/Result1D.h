@@ -2,8 +2,13 @@
 #define RESULT1D_H
 
 #include <iostream>
+#include <functional>
+#include <string>
+#include "DisplaySession.h"
+#include "FrameExporter.h"
 #include "HeatEquationSolver1D.h"
 #include "Material.h"
+#include "RunHandle.h"
 #include "Visualization.h"
 
 /**
@@ -21,6 +26,13 @@ namespace heat{
         int N_; /** Number of spatial divisions */
         int M_; /** Number of time steps */
         Material material_; /** The material for the simulation */
+        bool headless_; /** Write frames to disk instead of opening a window */
+        std::string exportPrefix_; /** Output path (without extension) of the headless export */
+        ExportFormat exportFormat_; /** Output format of the headless export */
+        DisplaySession* display_; /** Shared window the results are drawn in (null = open a window for this run) */
+        bool kymograph_; /** Show the run as one space-time heatmap instead of animating the profile */
+        static constexpr int framesInFlight = 8; /** Profiles buffered between the solver and the renderer */
+        static constexpr int kymographRefreshMs = 33; /** Shortest time between two heatmap redraws while solving */
 
     public:
         /**
@@ -35,7 +47,77 @@ namespace heat{
          * @param material : Material properties for the simulation
          */
         Result1D(double f, double tmax, double L, double u0, int N, int M, const Material& material)
-        : f_(f), t_max_(tmax), L_(L), u0_(u0), N_(N), M_(M), material_(material) {}
+        : f_(f), t_max_(tmax), L_(L), u0_(u0), N_(N), M_(M), material_(material), headless_(false), exportFormat_(ExportFormat::PNG), display_(nullptr), kymograph_(true) {}
+
+        /**
+         * @brief Draw in a shared display session instead of opening a window for this run
+         * 
+         * @param session : The session (must outlive runSimulation), or null for a private window
+         */
+        void setDisplaySession(DisplaySession* session) { display_ = session; }
+
+        /**
+         * @brief Write the results to image or video files instead of displaying them
+         * 
+         * No display is needed: SDL is not initialized when this is set.
+         * 
+         * @param pathPrefix : Output path without extension
+         * @param format : Output format (numbered PPM/PNG images or one Y4M stream)
+         */
+        void setHeadlessExport(const std::string& pathPrefix, ExportFormat format);
+
+        /**
+         * @brief Choose between the space-time heatmap (default) and the animated profile
+         * 
+         * The heatmap shows the whole evolution at once, x horizontally and time going down,
+         * and grows row by row while the solver runs.
+         * 
+         * @param enabled : true for the heatmap, false for the profile animation
+         */
+        void setKymographView(bool enabled) { kymograph_ = enabled; }
+
+        /**
+         * @brief Solve on a background thread and return at once, keeping every time step
+         * 
+         * The handle reports progress, can cancel the run (the solver stops within a few steps)
+         * and returns the solver when it is done, so the next run can be solving while this one
+         * is displayed with showResult().
+         * 
+         * @param onComplete : Called on the solver thread once the run is over, with the error if it failed (may be empty)
+         * @return Handle to the run
+         */
+        RunHandle<HeatEquationSolver1D> solveAsync(RunCallback<HeatEquationSolver1D> onComplete = nullptr) const;
+
+        /**
+         * @brief Solve on a background thread with rolling storage
+         * 
+         * Only two time steps are held by the solver; the steps selected by the policy go to the
+         * sink (e.g. FrameRing::sink()) on the solver thread. Use this when several runs are in
+         * flight at once: full storage of a large run takes hundreds of megabytes.
+         * 
+         * @param snapshots : Time steps passed to the sink
+         * @param sink : Receiver of the snapshots (must outlive the run); empty keeps every step in the solver
+         * @param onComplete : Called on the solver thread once the run is over, with the error if it failed (may be empty)
+         * @return Handle to the run
+         */
+        RunHandle<HeatEquationSolver1D> solveAsync(const SnapshotPolicy& snapshots, SnapshotSink sink,
+                                 RunCallback<HeatEquationSolver1D> onComplete = nullptr) const;
+
+        /**
+         * @brief Display a run solved by solveAsync (up to the last computed step if it was cancelled)
+         * 
+         * @param solver : The solver returned by the run handle
+         * @throws std::runtime_error if the run used rolling storage (show its FrameRing instead)
+         */
+        void showResult(const HeatEquationSolver1D& solver);
+
+        /**
+         * @brief Display the snapshots of a run solved with rolling storage into a frame ring
+         * 
+         * @param solver : The solver returned by the run handle (gives the color scale)
+         * @param frames : The profiles the run pushed into the ring (e.g. through FrameRing::rowSink())
+         */
+        void showResult(const HeatEquationSolver1D& solver, const FrameRing& frames);
 
         /**
          * @brief Run the heat equation solver and visualize results
@@ -1,6 +1,13 @@
 #include "Result2D.h"
+#include <exception>
+#include <future>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
 #include <vector>
+#include "FrameQueue.h"
+#include "Tracer.h"
 
 namespace heat {
 
@@ -10,15 +17,158 @@ namespace heat {
 
         HeatEquationSolver2D solver_(material_, heatSource, L_, t_max_, u0_, N_, M_); /**< Initialize the HeatEquationSolver1D with the provided parameters */
 
-        solver_.solve(); /**< Solve the heat equation using the finite difference method */
+        solver_.setThreadCount(threads_); /**< Spread the line sweeps over the hardware threads */
 
-        Visualization2D visualizer; /**< Initialize the Visualization object for rendering the results */
+        if (headless_) {
+            // Pull the frames one step at a time and export each as it is computed; only two frames stay in memory
+            double maxTemperature = u0_ + t_max_ * heatSource.maxValue() / (material_.density * material_.specificHeat);
+            FrameExporter exporter(exportPrefix_, exportFormat_, ColormapKind::BlueRed, u0_, maxTemperature);
+            solver_.setRollingStorage(SnapshotPolicy::every(1), nullptr);
+            for (FieldView frame : solver_.steps()) {
+                exporter.submit(frame);
+            }
+            exporter.finish();
+            return;
+        }
 
-        const auto& results = solver_.getAllTemperatureGrids(); /**< Store all Temperatuer Grid */
+        /** Initialize the Visualization object for rendering the results (in the shared window if there is one) */
+        std::unique_ptr<Visualization2D> ownedVisualizer(display_ ? new Visualization2D(*display_) : new Visualization2D());
+        Visualization2D& visualizer = *ownedVisualizer;
 
-        visualizer.showAllFrames(results, M_); /**< Visualize all frames */
-        
+        // The solver thread pushes each new frame into a small ring of recycled buffers and waits when it is full
+        FrameQueue queue(framesInFlight, N_, N_);
+        solver_.setRollingStorage(SnapshotPolicy::every(1), [&queue](int timeStep, const FieldView& frame) {
+            queue.push(timeStep, frame);
+        });
+
+        RunControl control;  /**< Lets the render loop stop the solver when the window is closed */
+        solver_.setRunControl(control);
+
+        std::exception_ptr solverError;
+        std::thread solverThread([&]() {
+            Tracer::global().nameThread("solver");
+            try {
+                solver_.solve(); /**< Solve the heat equation using the finite difference method */
+            } catch (...) {
+                solverError = std::current_exception();
+            }
+            queue.close();
+        });
+
+        // Render on this thread (SDL must stay on the thread that created the window) as frames arrive
+        FieldView frame;
+        int timeStep = 0;
+        FrameStats seen;
+        PlaybackController& playback = visualizer.playbackController();
+        playback.start(M_);
+        try {
+            while (queue.waitFront(frame, timeStep)) {
+                // The color scale follows the extremes seen so far, taken from the solver statistics (no pre-scan)
+                const FrameStats& stats = solver_.getFrameStats(timeStep);
+                if (seen.count == 0) {
+                    seen = stats;
+                } else {
+                    seen.merge(stats);
+                }
+                // Paced by the playback controller; late frames are skipped if a newer one is waiting
+                if (playback.waitFor(timeStep, queue.size() > 1)) {
+                    std::cout << "Timestep " << timeStep + 1 << " of " << M_ << std::endl;
+                    visualizer.setTemperatureRange(seen);
+                    visualizer.showFrame(frame);
+                }
+                queue.release();
+                if (playback.quit()) {
+                    control.cancel();
+                    queue.cancel(); /**< Window closed: stop the solver and discard the remaining frames */
+                    break;
+                }
+            }
+        } catch (...) {
+            control.cancel();
+            queue.cancel(); /**< Unblock the solver so it can be joined */
+            solverThread.join();
+            throw;
+        }
+        solverThread.join();
+
+        if (solverError) {
+            std::rethrow_exception(solverError);
+        }
+    }
+
+    RunHandle<HeatEquationSolver2D> Result2D::solveAsync(RunCallback<HeatEquationSolver2D> onComplete) const {
+        return solveAsync(SnapshotPolicy::every(1), nullptr, std::move(onComplete));
+    }
+
+    RunHandle<HeatEquationSolver2D> Result2D::solveAsync(const SnapshotPolicy& snapshots, FrameSink sink,
+                                                         RunCallback<HeatEquationSolver2D> onComplete) const {
+        RunControl control;
+        // Everything is captured by value: the run may outlive this object
+        double f = f_, tmax = t_max_, L = L_, u0 = u0_;
+        int N = N_, M = M_, threads = threads_;
+        Material material = material_;
+        std::shared_future<std::shared_ptr<HeatEquationSolver2D>> result = std::async(std::launch::async, [=]() {
+            std::shared_ptr<HeatEquationSolver2D> solver;
+            std::exception_ptr error;
+            try {
+                Heatsource2D heatSource(tmax, L, f);
+                solver = std::make_shared<HeatEquationSolver2D>(material, heatSource, L, tmax, u0, N, M);
+                solver->setThreadCount(threads);
+                solver->setRunControl(control);
+                if (sink) {
+                    solver->setRollingStorage(snapshots, sink);
+                }
+                solver->solve();
+            } catch (...) {
+                error = std::current_exception();
+            }
+            notifyRunComplete(onComplete, solver.get(), error);
+            if (error) {
+                std::rethrow_exception(error);
+            }
+            return solver;
+        }).share();
+        return RunHandle<HeatEquationSolver2D>(result, control);
+    }
+
+    void Result2D::showResult(const HeatEquationSolver2D& solver) {
+        if (solver.getAllTemperatureGrids().frames() < solver.lastComputedStep() + 1) {
+            throw std::runtime_error("The run kept only its last two steps: show the frame ring it filled instead");
+        }
+
+        std::unique_ptr<Visualization2D> ownedVisualizer(display_ ? new Visualization2D(*display_) : new Visualization2D());
+        Visualization2D& visualizer = *ownedVisualizer;
+
+        // The solver statistics give the color scale without a pass over the frames
+        visualizer.setTemperatureRange(solver.getSummaryStats());
+
+        PlaybackController& playback = visualizer.playbackController();
+        playback.start(solver.lastComputedStep() + 1);
+        for (int t = playback.nextFrame(); t >= 0; t = playback.nextFrame()) {
+            std::cout << "Timestep " << t + 1 << " of " << M_ << std::endl;
+            visualizer.showFrame(solver.getTemperatureAtTime(t));
+        }
     }
 
+    void Result2D::showResult(const HeatEquationSolver2D& solver, const FrameRing& frames) {
+        std::unique_ptr<Visualization2D> ownedVisualizer(display_ ? new Visualization2D(*display_) : new Visualization2D());
+        Visualization2D& visualizer = *ownedVisualizer;
+
+        // Statistics cover every computed step, not only the kept ones
+        visualizer.setTemperatureRange(solver.getSummaryStats());
+
+        PlaybackController& playback = visualizer.playbackController();
+        playback.start(frames.size());
+        for (int k = playback.nextFrame(); k >= 0; k = playback.nextFrame()) {
+            std::cout << "Timestep " << frames.timeStep(k) + 1 << " of " << M_ << std::endl;
+            visualizer.showFrame(frames.frame(k));
+        }
+    }
+
+    void Result2D::setHeadlessExport(const std::string& pathPrefix, ExportFormat format) {
+        headless_ = true;
+        exportPrefix_ = pathPrefix;
+        exportFormat_ = format;
+    }
 
 }
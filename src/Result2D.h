@@ -1,8 +1,13 @@
 #ifndef RESULT2D_H
 #define RESULT2D_H
 
+#include <functional>
+#include <string>
+#include "DisplaySession.h"
+#include "FrameExporter.h"
 #include "HeatEquationSolver2D.h"
 #include "Material.h"
+#include "RunHandle.h"
 #include "Visualization2D.h"
 
 namespace heat {
@@ -19,6 +24,12 @@ namespace heat {
         int N_; /** Number of spatial divisions */
         int M_; /** Number of time steps */
         Material material_; /** The material for the simulation */
+        bool headless_; /** Write frames to disk instead of opening a window */
+        std::string exportPrefix_; /** Output path (without extension) of the headless export */
+        ExportFormat exportFormat_; /** Output format of the headless export */
+        DisplaySession* display_; /** Shared window the results are drawn in (null = open a window for this run) */
+        int threads_; /** Threads of the solver sweeps (0 = hardware concurrency) */
+        static constexpr int framesInFlight = 4; /** Frames buffered between the solver and the renderer */
 
     public:
         /**
@@ -33,7 +44,76 @@ namespace heat {
          * @param material : Material properties for the simulation
          */
         Result2D(double f, double tmax, double L, double u0, int N, int M, const Material& material)
-        : f_(f), t_max_(tmax), L_(L), u0_(u0), N_(N), M_(M), material_(material) {}
+        : f_(f), t_max_(tmax), L_(L), u0_(u0), N_(N), M_(M), material_(material), headless_(false), exportFormat_(ExportFormat::PNG), display_(nullptr), threads_(0) {}
+
+        /**
+         * @brief Draw in a shared display session instead of opening a window for this run
+         * 
+         * @param session : The session (must outlive runSimulation), or null for a private window
+         */
+        void setDisplaySession(DisplaySession* session) { display_ = session; }
+
+        /**
+         * @brief Set the number of threads of the solver (every hardware thread by default)
+         * 
+         * Give a run solving in the background fewer threads than the one being drawn live.
+         * 
+         * @param threads : Total number of threads (1 = serial, 0 = hardware concurrency)
+         */
+        void setThreadCount(int threads) { threads_ = threads; }
+
+        /**
+         * @brief Write the results to image or video files instead of displaying them
+         * 
+         * No display is needed: SDL is not initialized when this is set.
+         * 
+         * @param pathPrefix : Output path without extension
+         * @param format : Output format (numbered PPM/PNG images or one Y4M stream)
+         */
+        void setHeadlessExport(const std::string& pathPrefix, ExportFormat format);
+
+        /**
+         * @brief Solve on a background thread and return at once, keeping every time step
+         * 
+         * The handle reports progress, can cancel the run (the solver stops within a few steps)
+         * and returns the solver when it is done, so the next run can be solving while this one
+         * is displayed with showResult().
+         * 
+         * @param onComplete : Called on the solver thread once the run is over, with the error if it failed (may be empty)
+         * @return Handle to the run
+         */
+        RunHandle<HeatEquationSolver2D> solveAsync(RunCallback<HeatEquationSolver2D> onComplete = nullptr) const;
+
+        /**
+         * @brief Solve on a background thread with rolling storage
+         * 
+         * Only two time steps are held by the solver; the steps selected by the policy go to the
+         * sink (e.g. FrameRing::sink()) on the solver thread. Use this when several runs are in
+         * flight at once: full storage of a large run takes hundreds of megabytes.
+         * 
+         * @param snapshots : Time steps passed to the sink
+         * @param sink : Receiver of the snapshots (must outlive the run); empty keeps every step in the solver
+         * @param onComplete : Called on the solver thread once the run is over, with the error if it failed (may be empty)
+         * @return Handle to the run
+         */
+        RunHandle<HeatEquationSolver2D> solveAsync(const SnapshotPolicy& snapshots, FrameSink sink,
+                                 RunCallback<HeatEquationSolver2D> onComplete = nullptr) const;
+
+        /**
+         * @brief Display a run solved by solveAsync (up to the last computed step if it was cancelled)
+         * 
+         * @param solver : The solver returned by the run handle
+         * @throws std::runtime_error if the run used rolling storage (show its FrameRing instead)
+         */
+        void showResult(const HeatEquationSolver2D& solver);
+
+        /**
+         * @brief Display the snapshots of a run solved with rolling storage into a frame ring
+         * 
+         * @param solver : The solver returned by the run handle (gives the color scale)
+         * @param frames : The snapshots the run pushed into the ring
+         */
+        void showResult(const HeatEquationSolver2D& solver, const FrameRing& frames);
 
         /**
          * @brief Show animation of the solution as a function of time
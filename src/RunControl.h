@@ -0,0 +1,60 @@
+#ifndef RUN_CONTROL_H
+#define RUN_CONTROL_H
+
+#include <atomic>
+#include <memory>
+
+namespace heat {
+
+    /**
+     * @brief Progress and cancellation state shared between a running solver and its callers.
+     *
+     * Copies share the same state, so a copy kept by the caller can watch the progress of,
+     * or cancel, the solve running on another thread. The solver only touches the state
+     * every few time steps, with relaxed atomics.
+     */
+    class RunControl {
+    private:
+        struct State {
+            std::atomic<bool> cancelled{false}; /**< Set by cancel() */
+            std::atomic<int> stepsDone{0};      /**< Time steps computed so far */
+            std::atomic<int> totalSteps{0};     /**< Time steps of the whole run */
+        };
+        std::shared_ptr<State> state_; /**< State shared by every copy */
+
+    public:
+        /**
+         * @brief Creates a new, independent state (not cancelled, no progress).
+         */
+        RunControl() : state_(std::make_shared<State>()) {}
+
+        /**
+         * @brief Asks the solver to stop at its next check.
+         */
+        void cancel() { state_->cancelled.store(true, std::memory_order_relaxed); }
+
+        bool cancelled() const { return state_->cancelled.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Called by the solver to publish its progress.
+         */
+        void reportProgress(int stepsDone, int totalSteps) {
+            state_->totalSteps.store(totalSteps, std::memory_order_relaxed);
+            state_->stepsDone.store(stepsDone, std::memory_order_relaxed);
+        }
+
+        int stepsDone() const { return state_->stepsDone.load(std::memory_order_relaxed); }
+        int totalSteps() const { return state_->totalSteps.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Fraction of the run computed so far (0 to 1).
+         */
+        double progress() const {
+            int total = totalSteps();
+            return total > 0 ? static_cast<double>(stepsDone()) / total : 0.0;
+        }
+    };
+
+}
+
+#endif
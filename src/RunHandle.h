@@ -0,0 +1,101 @@
+#ifndef RUN_HANDLE_H
+#define RUN_HANDLE_H
+
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <memory>
+#include "RunControl.h"
+
+namespace heat {
+
+    /**
+     * @brief Called on the solver thread once a run is over, whatever the outcome.
+     *
+     * @param solver The solver (null only if it could not be created)
+     * @param error What the solve threw (null if it finished or was cancelled)
+     */
+    template <class Solver>
+    using RunCallback = std::function<void(const Solver* solver, std::exception_ptr error)>;
+
+    /**
+     * @brief Calls a completion callback; its own exceptions are reported, not propagated.
+     *
+     * The outcome of the run (the solver or the solve error) must reach the handle even if
+     * the callback fails.
+     */
+    template <class Solver>
+    void notifyRunComplete(const RunCallback<Solver>& onComplete, const Solver* solver, std::exception_ptr error) {
+        if (!onComplete) {
+            return;
+        }
+        try {
+            onComplete(solver, error);
+        } catch (const std::exception& e) {
+            std::cerr << "Run completion callback error: " << e.what() << std::endl;
+        } catch (...) {
+            std::cerr << "Run completion callback error: unknown exception" << std::endl;
+        }
+    }
+
+    /**
+     * @brief Handle to a solve running on its own thread.
+     *
+     * Gives access to the solver once it has finished, its progress while it runs, and a
+     * way to cancel it; the solver stops within a few time steps and keeps what it computed.
+     * Handles are cheap to copy and all copies refer to the same run.
+     *
+     * @tparam Solver HeatEquationSolver1D or HeatEquationSolver2D
+     */
+    template <class Solver>
+    class RunHandle {
+    private:
+        std::shared_future<std::shared_ptr<Solver>> result_; /**< Solver once the run is over */
+        RunControl control_;                                 /**< Progress and cancellation of the run */
+
+    public:
+        RunHandle() = default;
+
+        RunHandle(std::shared_future<std::shared_ptr<Solver>> result, RunControl control)
+            : result_(std::move(result)), control_(std::move(control)) {}
+
+        /**
+         * @brief Whether the handle refers to a run.
+         */
+        bool valid() const { return result_.valid(); }
+
+        /**
+         * @brief Whether the run is over (finished, cancelled or failed); never blocks.
+         */
+        bool ready() const { return result_.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }
+
+        /**
+         * @brief Fraction of the time steps computed so far (0 to 1).
+         */
+        double progress() const { return control_.progress(); }
+
+        /**
+         * @brief Asks the run to stop; get() then returns the partially computed solver.
+         */
+        void cancel() { control_.cancel(); }
+
+        bool cancelled() const { return control_.cancelled(); }
+
+        /**
+         * @brief Blocks until the run is over.
+         */
+        void wait() const { result_.wait(); }
+
+        /**
+         * @brief Blocks until the run is over and returns the solver.
+         *
+         * @throws Whatever the solve threw
+         */
+        std::shared_ptr<Solver> get() const { return result_.get(); }
+    };
+
+}
+
+#endif
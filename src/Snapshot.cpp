@@ -0,0 +1,116 @@
+#include "Snapshot.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace heat {
+
+    SnapshotPolicy::SnapshotPolicy(int stride, std::vector<int> steps) : stride_(stride), steps_(std::move(steps)) {
+        std::sort(steps_.begin(), steps_.end());
+        steps_.erase(std::unique(steps_.begin(), steps_.end()), steps_.end());
+    }
+
+    SnapshotPolicy SnapshotPolicy::every(int stride) {
+        return SnapshotPolicy(stride > 0 ? stride : 1, {});
+    }
+
+    SnapshotPolicy SnapshotPolicy::atSteps(std::vector<int> steps) {
+        return SnapshotPolicy(0, std::move(steps));
+    }
+
+    SnapshotPolicy SnapshotPolicy::atTimes(const std::vector<double>& times, double dt) {
+        std::vector<int> steps;
+        for (double time : times) {
+            steps.push_back(static_cast<int>(std::lround(time / dt)));
+        }
+        return SnapshotPolicy(0, std::move(steps));
+    }
+
+    SnapshotPolicy SnapshotPolicy::logSpaced(int count, int lastStep) {
+        std::vector<int> steps;
+        if (count > 1 && lastStep > 1) {
+            double ratio = std::log(static_cast<double>(lastStep)) / (count - 1);
+            for (int k = 0; k < count; ++k) {
+                steps.push_back(static_cast<int>(std::lround(std::exp(ratio * k))));
+            }
+        }
+        return SnapshotPolicy(0, std::move(steps));
+    }
+
+    bool SnapshotPolicy::selects(int timeStep, int lastStep) const {
+        if (timeStep == 0 || timeStep == lastStep) {
+            return true;
+        }
+        if (stride_ > 0) {
+            return timeStep % stride_ == 0;
+        }
+        return std::binary_search(steps_.begin(), steps_.end(), timeStep);
+    }
+
+    int SnapshotPolicy::selectedCount(int lastStep) const {
+        int count = 0;
+        for (int t = 0; t <= lastStep; ++t) {
+            if (selects(t, lastStep)) {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    FrameRing::FrameRing(int capacity, int rows, int cols)
+        : capacity_(capacity > 0 ? capacity : 1), rows_(rows), cols_(cols), rowStride_((cols + 7) & ~7),
+          frames_(static_cast<std::size_t>(capacity > 0 ? capacity : 1) * rows * ((cols + 7) & ~7)),
+          steps_(capacity > 0 ? capacity : 1, -1), head_(0), count_(0) {}
+
+    void FrameRing::push(int timeStep, const FieldView& frame) {
+        double* slot = frames_.data() + static_cast<std::size_t>(head_) * rows_ * rowStride_;
+        for (int i = 0; i < rows_; ++i) {
+            std::copy(frame.row(i), frame.row(i) + cols_, slot + static_cast<std::size_t>(i) * rowStride_);
+        }
+        steps_[head_] = timeStep;
+        head_ = (head_ + 1) % capacity_;
+        count_ = std::min(count_ + 1, capacity_);
+    }
+
+    FieldView FrameRing::frame(int k) const {
+        int slot = (head_ - count_ + k + capacity_) % capacity_;
+        return FieldView(frames_.data() + static_cast<std::size_t>(slot) * rows_ * rowStride_, rows_, cols_, rowStride_);
+    }
+
+    int FrameRing::timeStep(int k) const {
+        return steps_[(head_ - count_ + k + capacity_) % capacity_];
+    }
+
+    FrameSink FrameRing::sink() {
+        return [this](int timeStep, const FieldView& frame) { push(timeStep, frame); };
+    }
+
+    std::function<void(int, const double*, int)> FrameRing::rowSink() {
+        return [this](int timeStep, const double* temperature, int size) { push(timeStep, FieldView(temperature, 1, size)); };
+    }
+
+    FrameFileWriter::FrameFileWriter(const std::string& path) : out_(path, std::ios::binary | std::ios::trunc) {
+        if (!out_) {
+            throw std::runtime_error("Failed to open snapshot file " + path);
+        }
+    }
+
+    void FrameFileWriter::write(int timeStep, const FieldView& frame) {
+        std::int32_t header[3] = {timeStep, frame.rows(), frame.cols()};
+        out_.write(reinterpret_cast<const char*>(header), sizeof(header));
+        for (int i = 0; i < frame.rows(); ++i) {
+            out_.write(reinterpret_cast<const char*>(frame.row(i)), static_cast<std::streamsize>(frame.cols() * sizeof(double)));
+        }
+        if (!out_) {
+            throw std::runtime_error("Failed to write snapshot of time step " + std::to_string(timeStep));
+        }
+    }
+
+    FrameSink FrameFileWriter::sink() {
+        return [this](int timeStep, const FieldView& frame) { write(timeStep, frame); };
+    }
+
+}
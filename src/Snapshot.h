@@ -0,0 +1,181 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+#include "AlignedBuffer.h"
+#include "FieldView.h"
+
+namespace heat {
+
+    /**
+     * @brief Storage policy for the temperature history of a solver.
+     */
+    enum class StorageMode {
+        Full,    /**< Keep every time step */
+        Rolling  /**< Keep only the current and the next time step */
+    };
+
+    /**
+     * @brief Callback receiving a snapshot of a 2D temperature frame.
+     *
+     * @param timeStep The time step index of the snapshot
+     * @param frame View of the frame (valid only during the call)
+     */
+    using FrameSink = std::function<void(int timeStep, const FieldView& frame)>;
+
+    /**
+     * @brief Decides which time steps are sent to a snapshot sink.
+     *
+     * Step 0 and the last step are always selected.
+     */
+    class SnapshotPolicy {
+    private:
+        int stride_;             /**< Select every stride_-th step (0 when steps_ is used) */
+        std::vector<int> steps_; /**< Explicit sorted list of selected steps */
+
+        SnapshotPolicy(int stride, std::vector<int> steps);
+
+    public:
+        /**
+         * @brief Selects every stride-th time step.
+         *
+         * @param stride Snapshot interval in time steps (>= 1)
+         */
+        static SnapshotPolicy every(int stride);
+
+        /**
+         * @brief Selects the given time steps.
+         *
+         * @param steps Time step indices (any order, duplicates allowed)
+         */
+        static SnapshotPolicy atSteps(std::vector<int> steps);
+
+        /**
+         * @brief Selects the time steps closest to the given times.
+         *
+         * @param times Simulation times in seconds
+         * @param dt Time step size
+         */
+        static SnapshotPolicy atTimes(const std::vector<double>& times, double dt);
+
+        /**
+         * @brief Selects about count steps spaced logarithmically between 1 and lastStep.
+         *
+         * Early steps, where the field changes fastest, are sampled densely.
+         *
+         * @param count Number of snapshots wanted
+         * @param lastStep Index of the last time step (M - 1)
+         */
+        static SnapshotPolicy logSpaced(int count, int lastStep);
+
+        /**
+         * @brief Returns whether a time step is selected.
+         *
+         * @param timeStep The time step index
+         * @param lastStep Index of the last time step (M - 1)
+         */
+        bool selects(int timeStep, int lastStep) const;
+
+        /**
+         * @brief Number of time steps selected in a run (e.g. the capacity of a FrameRing keeping them all).
+         *
+         * @param lastStep Index of the last time step (M - 1)
+         */
+        int selectedCount(int lastStep) const;
+    };
+
+    /**
+     * @brief In-memory ring holding the most recent snapshot frames.
+     *
+     * All frames live in one aligned block; once the ring is full the oldest frame is overwritten.
+     */
+    class FrameRing {
+    private:
+        int capacity_;            /**< Maximum number of frames */
+        int rows_;                /**< Rows per frame */
+        int cols_;                /**< Values per row */
+        int rowStride_;           /**< cols_ padded to a cache line */
+        AlignedBuffer frames_;    /**< capacity_ frames, frame-major */
+        std::vector<int> steps_;  /**< Time step of each slot */
+        int head_;                /**< Slot receiving the next frame */
+        int count_;               /**< Number of frames held */
+
+    public:
+        /**
+         * @brief Allocates the ring.
+         *
+         * @param capacity Maximum number of frames kept
+         * @param rows Rows per frame
+         * @param cols Values per row
+         */
+        FrameRing(int capacity, int rows, int cols);
+
+        /**
+         * @brief Copies a frame into the ring, dropping the oldest frame if full.
+         */
+        void push(int timeStep, const FieldView& frame);
+
+        /**
+         * @brief Number of frames held.
+         */
+        int size() const { return count_; }
+
+        /**
+         * @brief Frame k, from the oldest (0) to the newest (size-1).
+         */
+        FieldView frame(int k) const;
+
+        /**
+         * @brief Time step of frame k, from the oldest (0) to the newest (size-1).
+         */
+        int timeStep(int k) const;
+
+        /**
+         * @brief Returns a sink pushing into this ring (the ring must outlive the sink).
+         */
+        FrameSink sink();
+
+        /**
+         * @brief Returns a sink for 1D snapshots pushing each profile as a one-row frame (the ring must outlive the sink).
+         */
+        std::function<void(int timeStep, const double* temperature, int size)> rowSink();
+    };
+
+    /**
+     * @brief On-disk snapshot sink writing raw frames to a binary file.
+     *
+     * Each record is three 32-bit integers (time step, rows, cols) followed by
+     * rows * cols doubles in row-major order, in the native byte order.
+     */
+    class FrameFileWriter {
+    private:
+        std::ofstream out_; /**< Output file */
+
+    public:
+        /**
+         * @brief Opens (and truncates) the output file.
+         *
+         * @param path Path of the file
+         * @throws std::runtime_error if the file cannot be opened
+         */
+        explicit FrameFileWriter(const std::string& path);
+
+        /**
+         * @brief Appends one frame to the file.
+         *
+         * @throws std::runtime_error if the frame could not be written (e.g. disk full)
+         */
+        void write(int timeStep, const FieldView& frame);
+
+        /**
+         * @brief Returns a sink writing into this file (the writer must outlive the sink).
+         */
+        FrameSink sink();
+    };
+
+}
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef STEP_RANGE_H
+#define STEP_RANGE_H
+
+#include <cstddef>
+#include <iterator>
+#include "FieldView.h"
+
+namespace heat {
+
+    /**
+     * @brief Lazy range over the time steps of a solver, computing one step per increment.
+     *
+     * begin() starts the solve and yields step 0; each ++ advances the solver by one step
+     * and the range ends after the last step (or once the run is cancelled). Nothing is
+     * computed ahead of the consumer: leaving the loop early stops the solve, and with
+     * rolling storage only two frames are ever held. Dereferencing gives a view of the
+     * current field, valid until the next increment.
+     *
+     *     for (FieldView field : solver.steps()) { ... }
+     *
+     * @tparam Solver A solver with start(), advance(), currentField() and lastComputedStep()
+     */
+    template <class Solver>
+    class StepRange {
+    private:
+        Solver* solver_; /**< Solver being stepped */
+
+    public:
+        /**
+         * @brief Input iterator over the computed steps.
+         */
+        class iterator {
+        private:
+            Solver* solver_; /**< Null once past the last step */
+
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = FieldView;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const FieldView*;
+            using reference = FieldView;
+
+            explicit iterator(Solver* solver = nullptr) : solver_(solver) {}
+
+            FieldView operator*() const { return solver_->currentField(); }
+
+            /**
+             * @brief Time step of the current field.
+             */
+            int timeStep() const { return solver_->lastComputedStep(); }
+
+            iterator& operator++() {
+                if (!solver_->advance()) {
+                    solver_ = nullptr;
+                }
+                return *this;
+            }
+
+            bool operator==(const iterator& other) const { return solver_ == other.solver_; }
+            bool operator!=(const iterator& other) const { return solver_ != other.solver_; }
+        };
+
+        explicit StepRange(Solver& solver) : solver_(&solver) {}
+
+        /**
+         * @brief Starts (or restarts) the solve and returns an iterator on step 0.
+         */
+        iterator begin() {
+            solver_->start();
+            return iterator(solver_);
+        }
+
+        iterator end() { return iterator(); }
+    };
+
+}
+
+#endif
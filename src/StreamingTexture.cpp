@@ -0,0 +1,49 @@
+#include "StreamingTexture.h"
+#include "Metrics.h"
+
+namespace heat {
+
+    StreamingTexture::~StreamingTexture() {
+        release();
+    }
+
+    void StreamingTexture::release() {
+        if (texture_) SDL_DestroyTexture(texture_);
+        texture_ = nullptr;
+        width_ = 0;
+        height_ = 0;
+    }
+
+    bool StreamingTexture::upload(SDL_Renderer* renderer, int width, int height, const Uint32* pixels) {
+        if (!texture_ || width != width_ || height != height_) {
+            release();
+            texture_ = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, width, height);
+            if (!texture_) {
+                return false;
+            }
+            width_ = width;
+            height_ = height;
+        }
+        HEAT_METRIC_SCOPE(MetricPhase::TextureUpload, sizeof(Uint32) * width * height);
+        return SDL_UpdateTexture(texture_, nullptr, pixels, width * static_cast<int>(sizeof(Uint32))) == 0;
+    }
+
+    bool StreamingTexture::uploadRows(SDL_Renderer* renderer, int width, int height, const Uint32* pixels, int firstRow, int rowCount) {
+        if (!texture_ || width != width_ || height != height_) {
+            return upload(renderer, width, height, pixels);
+        }
+        if (rowCount <= 0) {
+            return true;
+        }
+        HEAT_METRIC_SCOPE(MetricPhase::TextureUpload, sizeof(Uint32) * width * rowCount);
+        SDL_Rect band = {0, firstRow, width, rowCount};
+        return SDL_UpdateTexture(texture_, &band, pixels + static_cast<size_t>(firstRow) * width, width * static_cast<int>(sizeof(Uint32))) == 0;
+    }
+
+    void StreamingTexture::draw(SDL_Renderer* renderer, const SDL_Rect* destination) const {
+        if (texture_) {
+            SDL_RenderCopy(renderer, texture_, nullptr, destination);
+        }
+    }
+
+}
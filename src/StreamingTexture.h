@@ -0,0 +1,74 @@
+#ifndef STREAMING_TEXTURE_H
+#define STREAMING_TEXTURE_H
+
+#include <SDL2/SDL.h>
+
+namespace heat {
+
+    /**
+     * @brief Streaming SDL texture receiving whole frames of packed ARGB8888 pixels.
+     *
+     * A frame is uploaded with one SDL_UpdateTexture call and drawn with one SDL_RenderCopy;
+     * the renderer scales it to the destination. The texture is only recreated when the
+     * frame size changes.
+     */
+    class StreamingTexture {
+    private:
+        SDL_Texture* texture_; /**< SDL texture (null until the first upload) */
+        int width_;            /**< Width of the texture in pixels */
+        int height_;           /**< Height of the texture in pixels */
+
+    public:
+        StreamingTexture() : texture_(nullptr), width_(0), height_(0) {}
+
+        /**
+         * @brief Destroys the SDL texture.
+         */
+        ~StreamingTexture();
+
+        StreamingTexture(const StreamingTexture&) = delete;
+        StreamingTexture& operator=(const StreamingTexture&) = delete;
+
+        /**
+         * @brief Uploads a frame, (re)creating the texture if its size changed.
+         *
+         * @param renderer Renderer owning the texture
+         * @param width Width of the frame in pixels
+         * @param height Height of the frame in pixels
+         * @param pixels width * height packed ARGB8888 pixels, row-major
+         * @return false if the texture could not be created or updated
+         */
+        bool upload(SDL_Renderer* renderer, int width, int height, const Uint32* pixels);
+
+        /**
+         * @brief Uploads a band of rows of a frame, e.g. rows appended since the last upload.
+         *
+         * If the texture has to be (re)created the whole frame is uploaded instead.
+         *
+         * @param renderer Renderer owning the texture
+         * @param width Width of the frame in pixels
+         * @param height Height of the frame in pixels
+         * @param pixels The whole frame, width * height packed ARGB8888 pixels, row-major
+         * @param firstRow First row to upload
+         * @param rowCount Number of rows to upload
+         * @return false if the texture could not be created or updated
+         */
+        bool uploadRows(SDL_Renderer* renderer, int width, int height, const Uint32* pixels, int firstRow, int rowCount);
+
+        /**
+         * @brief Draws the last uploaded frame, scaled to a rectangle.
+         *
+         * @param renderer Renderer owning the texture
+         * @param destination Target rectangle (null = the whole render target)
+         */
+        void draw(SDL_Renderer* renderer, const SDL_Rect* destination = nullptr) const;
+
+        /**
+         * @brief Destroys the SDL texture (e.g. before its renderer is destroyed).
+         */
+        void release();
+    };
+
+}
+
+#endif
@@ -0,0 +1,166 @@
+#include "SweepScheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <numeric>
+#include "BatchHeatSolver1D.h"
+#include "HeatEquationSolver1D.h"
+#include "HeatEquationSolver2D.h"
+#include "Heatsource1D.h"
+#include "Heatsource2D.h"
+#include "ThreadPool.h"
+
+namespace heat {
+
+    namespace {
+
+        /** Whether two rods can advance in the lanes of the same batch */
+        bool sameRodGrid(const SweepJob& a, const SweepJob& b) {
+            return a.dimension == 1 && b.dimension == 1 && a.N == b.N && a.M == b.M &&
+                   a.tmax == b.tmax && a.L == b.L && a.u0 == b.u0;
+        }
+
+    }
+
+    SweepResult::SweepResult(const SweepJob& job)
+        : job(job), frames(job.snapshots.selectedCount(job.M - 1), job.dimension == 2 ? job.N : 1, job.N),
+          seconds(0.0), completed(false) {}
+
+    int SweepScheduler::addJob(const SweepJob& job) {
+        jobs_.push_back(job);
+        return static_cast<int>(jobs_.size()) - 1;
+    }
+
+    double SweepScheduler::estimatedCost(const SweepJob& job) {
+        double points = job.dimension == 2 ? 2.0 * job.N * job.N : static_cast<double>(job.N);
+        return points * job.M;
+    }
+
+    void SweepScheduler::runJob(SweepResult& result) {
+        const SweepJob& job = result.job;
+        auto start = std::chrono::steady_clock::now();
+        try {
+            if (job.dimension == 2) {
+                Heatsource2D source(job.tmax, job.L, job.f);
+                HeatEquationSolver2D solver(job.material, source, job.L, job.tmax, job.u0, job.N, job.M);
+                solver.setRollingStorage(job.snapshots, result.frames.sink());
+                solver.solve();
+                result.stats = solver.getSummaryStats();
+            } else {
+                Heatsource1D source(job.tmax, job.L, job.f);
+                HeatEquationSolver1D solver(job.material, source, job.L, job.tmax, job.u0, job.N, job.M);
+                FrameRing& frames = result.frames;
+                solver.setRollingStorage(job.snapshots, [&frames](int timeStep, const double* temperature, int size) {
+                    frames.push(timeStep, FieldView(temperature, 1, size));
+                });
+                solver.solve();
+                result.stats = solver.getSummaryStats();
+            }
+            result.completed = true;
+        } catch (const std::exception& e) {
+            result.error = e.what();
+        } catch (...) {
+            result.error = "unknown exception"; /** Must not escape the pool worker */
+        }
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void SweepScheduler::runBatch(const std::vector<SweepResult*>& batch) {
+        const SweepJob& grid = batch.front()->job;
+        auto start = std::chrono::steady_clock::now();
+        try {
+            BatchHeatSolver1D solver(grid.L, grid.tmax, grid.u0, grid.N, grid.M);
+            std::vector<FrameStats> stats;
+            for (SweepResult* result : batch) {
+                const SweepJob& job = result->job;
+                solver.addRod(job.material, job.f);
+                /** Same histogram range as HeatEquationSolver1D */
+                Heatsource1D source(job.tmax, job.L, job.f);
+                stats.emplace_back(job.u0, job.u0 + job.tmax * source.maxValue() / (job.material.density * job.material.specificHeat));
+            }
+
+            // Every step goes through the sink for the statistics; only the selected ones are stored
+            solver.setSnapshotSink(1, [&](int rod, int timeStep, const double* temperature, int size) {
+                SweepResult& result = *batch[rod];
+                stats[rod].accumulate(temperature, size);
+                if (result.job.snapshots.selects(timeStep, result.job.M - 1)) {
+                    result.frames.push(timeStep, FieldView(temperature, 1, size));
+                }
+            });
+            solver.solve();
+
+            for (std::size_t k = 0; k < batch.size(); ++k) {
+                batch[k]->stats = stats[k];
+                batch[k]->completed = true;
+            }
+        } catch (const std::exception& e) {
+            for (SweepResult* result : batch) {
+                result->error = e.what();
+            }
+        } catch (...) {
+            for (SweepResult* result : batch) {
+                result->error = "unknown exception"; /** Must not escape the pool worker */
+            }
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        for (SweepResult* result : batch) {
+            result->seconds = seconds;
+        }
+    }
+
+    void SweepScheduler::run() {
+        results_.clear();
+        results_.reserve(jobs_.size()); /** Sinks point into the results: no reallocation while running */
+        for (const SweepJob& job : jobs_) {
+            results_.emplace_back(job);
+        }
+
+        // Tasks: one per plate, and rods sharing a grid grouped up to the batch width
+        std::vector<std::vector<int>> tasks;
+        for (int j = 0; j < static_cast<int>(jobs_.size()); ++j) {
+            bool placed = false;
+            for (std::vector<int>& task : tasks) {
+                if (sameRodGrid(jobs_[task.front()], jobs_[j]) && static_cast<int>(task.size()) < BatchHeatSolver1D::lanes) {
+                    task.push_back(j);
+                    placed = true;
+                    break;
+                }
+            }
+            if (!placed) {
+                tasks.push_back({j});
+            }
+        }
+        std::vector<double> cost(tasks.size(), 0.0);
+        for (std::size_t k = 0; k < tasks.size(); ++k) {
+            for (int j : tasks[k]) {
+                cost[k] += estimatedCost(jobs_[j]);
+            }
+        }
+
+        // Longest tasks first; equal costs keep their submission order
+        std::vector<int> order(tasks.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&cost](int a, int b) {
+            return cost[a] > cost[b];
+        });
+
+        // One task per chunk: a free thread takes the next task in cost order
+        ThreadPool pool(std::min<int>(threads_ > 0 ? threads_ : static_cast<int>(std::max(1u, std::thread::hardware_concurrency())),
+                                      std::max<int>(1, static_cast<int>(tasks.size()))));
+        pool.parallelFor(0, static_cast<int>(order.size()), Partitioning::Dynamic, [&](int first, int last, int) {
+            for (int k = first; k < last; ++k) {
+                const std::vector<int>& task = tasks[order[k]];
+                if (task.size() == 1) {
+                    runJob(results_[task.front()]);
+                    continue;
+                }
+                std::vector<SweepResult*> batch;
+                for (int j : task) {
+                    batch.push_back(&results_[j]);
+                }
+                runBatch(batch);
+            }
+        }, 1);
+    }
+
+}
@@ -0,0 +1,121 @@
+#ifndef SWEEP_SCHEDULER_H
+#define SWEEP_SCHEDULER_H
+
+#include <string>
+#include <vector>
+#include "FrameStats.h"
+#include "Material.h"
+#include "Snapshot.h"
+
+namespace heat {
+
+    /**
+     * @brief One simulation of a parameter sweep.
+     */
+    struct SweepJob {
+        Material material; /** Material of the rod or plate */
+        int dimension;     /** 1 (rod) or 2 (plate) */
+        int N;             /** Number of spatial points (per direction in 2D) */
+        int M;             /** Number of time steps */
+        double f;          /** Heat source intensity factor */
+        double tmax;       /** Simulated time in seconds */
+        double L;          /** Length of the domain */
+        double u0;         /** Initial temperature */
+        SnapshotPolicy snapshots; /** Time steps kept in the result */
+
+        /**
+         * @brief Describes a job keeping every time step.
+         */
+        SweepJob(const Material& material, int dimension, int N, int M, double f,
+                 double tmax = 16.0, double L = 1.0, double u0 = 286.15)
+            : material(material), dimension(dimension), N(N), M(M), f(f), tmax(tmax), L(L), u0(u0),
+              snapshots(SnapshotPolicy::every(1)) {}
+    };
+
+    /**
+     * @brief Outcome of a sweep job, collected for later display or export.
+     */
+    struct SweepResult {
+        SweepJob job;      /** The job that produced this result */
+        FrameRing frames;  /** Snapshots selected by job.snapshots (1 x N rows in 1D, N x N in 2D) */
+        FrameStats stats;  /** Statistics of every time step, merged */
+        double seconds;    /** Wall time of the solve (of the whole batch for batched rods) */
+        bool completed;    /** Whether the solve finished */
+        std::string error; /** Error message if it did not */
+
+        /**
+         * @brief Allocates room for every snapshot the job selects.
+         */
+        explicit SweepResult(const SweepJob& job);
+
+        /**
+         * @brief The last snapshot (the final state once completed).
+         */
+        FieldView finalFrame() const { return frames.frame(frames.size() - 1); }
+    };
+
+    /**
+     * @brief Runs a list of independent simulations concurrently.
+     *
+     * Jobs are started from the most to the least expensive (2D before 1D, then by grid
+     * size and step count) and handed out one at a time to whichever thread is free, so
+     * the long jobs start first and the short ones fill the gaps: the sweep takes about as
+     * long as its longest job once there are enough threads. Each plate builds its own solver
+     * with rolling storage and runs it single-threaded. Rods sharing a grid (N, M, tmax, L
+     * and u0) are solved together by BatchHeatSolver1D, up to BatchHeatSolver1D::lanes per
+     * task; a rod with no partner uses HeatEquationSolver1D. Only the selected snapshots are kept.
+     */
+    class SweepScheduler {
+    private:
+        int threads_;                     /**< Threads running jobs (0 = hardware concurrency) */
+        std::vector<SweepJob> jobs_;      /**< Jobs in submission order */
+        std::vector<SweepResult> results_; /**< Results in submission order */
+
+        /**
+         * @brief Solves one job into its result slot.
+         */
+        static void runJob(SweepResult& result);
+
+        /**
+         * @brief Solves rods sharing one grid in a single BatchHeatSolver1D.
+         *
+         * @param batch Result slots of the rods (2 to BatchHeatSolver1D::lanes)
+         */
+        static void runBatch(const std::vector<SweepResult*>& batch);
+
+    public:
+        /**
+         * @brief Creates an empty sweep.
+         *
+         * @param threads Number of jobs running at once (0 = hardware concurrency)
+         */
+        explicit SweepScheduler(int threads = 0) : threads_(threads) {}
+
+        /**
+         * @brief Adds a job.
+         *
+         * @return Index of the job (and of its result)
+         */
+        int addJob(const SweepJob& job);
+
+        /**
+         * @brief Relative cost of a job (grid points times time steps, 2D lines counted twice).
+         */
+        static double estimatedCost(const SweepJob& job);
+
+        /**
+         * @brief Runs every job and waits for all of them.
+         *
+         * A job that throws is reported in its result and does not stop the others.
+         */
+        void run();
+
+        /**
+         * @brief Results in submission order (valid after run()).
+         */
+        const std::vector<SweepResult>& results() const { return results_; }
+    };
+
+}
+
+#endif
@@ -0,0 +1,107 @@
+#include "ThreadPool.h"
+#include <algorithm>
+#include <string>
+#include "Tracer.h"
+
+namespace heat {
+
+    ThreadPool::ThreadPool(int threadCount)
+        : task_(nullptr), begin_(0), end_(0), grain_(1), partitioning_(Partitioning::Static),
+          next_(0), generation_(0), pending_(0), stopping_(false) {
+        if (threadCount <= 0) {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        for (int w = 1; w < threadCount; ++w) {
+            workers_.emplace_back(&ThreadPool::workerLoop, this, w);
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::workerLoop(int worker) {
+        Tracer::global().nameThread("pool worker " + std::to_string(worker));
+        unsigned long seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+                if (stopping_) {
+                    return;
+                }
+                seen = generation_;
+            }
+
+            runShare(worker);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (--pending_ == 0) {
+                    done_.notify_one();
+                }
+            }
+        }
+    }
+
+    void ThreadPool::runShare(int worker) {
+        if (partitioning_ == Partitioning::Static) {
+            /** Contiguous block per worker; the first (count % size) workers take one extra iteration */
+            int count = end_ - begin_;
+            int threads = size();
+            int base = count / threads;
+            int extra = count % threads;
+            int first = begin_ + worker * base + std::min(worker, extra);
+            int last = first + base + (worker < extra ? 1 : 0);
+            if (first < last) {
+                (*task_)(first, last, worker);
+            }
+            return;
+        }
+
+        while (true) {
+            int first = next_.fetch_add(grain_);
+            if (first >= end_) {
+                return;
+            }
+            (*task_)(first, std::min(first + grain_, end_), worker);
+        }
+    }
+
+    void ThreadPool::parallelFor(int begin, int end, Partitioning partitioning, const RangeTask& body, int grain) {
+        if (begin >= end) {
+            return;
+        }
+        if (workers_.empty()) {
+            body(begin, end, 0);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            task_ = &body;
+            begin_ = begin;
+            end_ = end;
+            grain_ = std::max(1, grain);
+            partitioning_ = partitioning;
+            next_.store(begin);
+            pending_ = static_cast<int>(workers_.size());
+            ++generation_;
+        }
+        wake_.notify_all();
+
+        runShare(0);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [&] { return pending_ == 0; });
+        task_ = nullptr;
+    }
+
+}
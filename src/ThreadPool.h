@@ -0,0 +1,94 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace heat {
+
+    /**
+     * @brief How the iterations of a parallel loop are distributed over the threads.
+     */
+    enum class Partitioning {
+        Static,  /**< One contiguous block of iterations per thread */
+        Dynamic  /**< Threads repeatedly grab the next chunk of iterations until none are left */
+    };
+
+    /**
+     * @brief Fixed set of worker threads running parallel loops.
+     *
+     * The calling thread takes part in every loop as worker 0, so a pool of size 1 has no
+     * extra thread and runs everything serially.
+     */
+    class ThreadPool {
+    public:
+        /**
+         * @brief Body of a parallel loop, called on [begin, end) by the given worker.
+         */
+        using RangeTask = std::function<void(int begin, int end, int worker)>;
+
+    private:
+        std::vector<std::thread> workers_;   /**< Threads 1..size-1 */
+        std::mutex mutex_;                   /**< Protects the fields below */
+        std::condition_variable wake_;       /**< Signals a new loop (or shutdown) to the workers */
+        std::condition_variable done_;       /**< Signals the end of the current loop to the caller */
+        const RangeTask* task_;              /**< Body of the current loop */
+        int begin_;                          /**< First iteration of the current loop */
+        int end_;                            /**< One past the last iteration of the current loop */
+        int grain_;                          /**< Chunk size for dynamic partitioning */
+        Partitioning partitioning_;          /**< Partitioning of the current loop */
+        std::atomic<int> next_;              /**< Next unclaimed iteration (dynamic partitioning) */
+        unsigned long generation_;           /**< Incremented for every loop */
+        int pending_;                        /**< Workers still running the current loop */
+        bool stopping_;                      /**< Set when the pool is destroyed */
+
+        /**
+         * @brief Main loop of worker threads.
+         */
+        void workerLoop(int worker);
+
+        /**
+         * @brief Runs this worker's share of the current loop.
+         */
+        void runShare(int worker);
+
+    public:
+        /**
+         * @brief Starts the worker threads.
+         *
+         * @param threadCount Total number of threads including the caller (0 = hardware concurrency)
+         */
+        explicit ThreadPool(int threadCount = 0);
+
+        /**
+         * @brief Stops and joins the worker threads.
+         */
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * @brief Total number of threads including the caller.
+         */
+        int size() const { return static_cast<int>(workers_.size()) + 1; }
+
+        /**
+         * @brief Runs body over [begin, end) on all threads and waits for completion.
+         *
+         * @param begin First iteration
+         * @param end One past the last iteration
+         * @param partitioning Static blocks or dynamic chunks
+         * @param body Loop body, called with sub-ranges and the index of the worker (0 to size-1)
+         * @param grain Number of iterations per chunk for dynamic partitioning
+         */
+        void parallelFor(int begin, int end, Partitioning partitioning, const RangeTask& body, int grain = 1);
+    };
+
+}
+
+#endif
@@ -0,0 +1,158 @@
+#include "Tracer.h"
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+namespace heat {
+
+    namespace {
+
+        /** Quotes and escapes a string for JSON */
+        void writeString(std::ostream& os, const char* text) {
+            os << '"';
+            for (const char* c = text; *c; ++c) {
+                if (*c == '"' || *c == '\\') {
+                    os << '\\' << *c;
+                } else if (static_cast<unsigned char>(*c) < 0x20) {
+                    os << ' ';
+                } else {
+                    os << *c;
+                }
+            }
+            os << '"';
+        }
+
+        /** Nanoseconds as trace microseconds with three decimals */
+        void writeMicroseconds(std::ostream& os, std::int64_t nanoseconds) {
+            char text[32];
+            std::snprintf(text, sizeof(text), "%.3f", nanoseconds / 1000.0);
+            os << text;
+        }
+
+    }
+
+    Tracer::Tracer() : enabled_(false), generation_(0), capacity_(0), epoch_(std::chrono::steady_clock::now()) {}
+
+    Tracer& Tracer::global() {
+        static Tracer tracer;
+        return tracer;
+    }
+
+    Tracer::ThreadBuffer& Tracer::localBuffer() {
+        /** Buffers are never freed before the tracer, so the cached pointer stays valid */
+        thread_local ThreadBuffer* local = nullptr;
+        if (!local) {
+            std::lock_guard<std::mutex> lock(registryMutex_);
+            std::unique_ptr<ThreadBuffer> buffer(new ThreadBuffer());
+            buffer->tid = static_cast<int>(buffers_.size()) + 1;
+            buffer->generation.store(0, std::memory_order_relaxed);
+            buffer->count.store(0, std::memory_order_relaxed);
+            buffer->dropped.store(0, std::memory_order_relaxed);
+            local = buffer.get();
+            buffers_.push_back(std::move(buffer));
+        }
+        return *local;
+    }
+
+    void Tracer::start(std::size_t eventsPerThread) {
+        enabled_.store(false, std::memory_order_relaxed);
+        capacity_ = eventsPerThread;
+        epoch_ = std::chrono::steady_clock::now();
+        generation_.fetch_add(1, std::memory_order_release);
+        enabled_.store(true, std::memory_order_release);
+    }
+
+    void Tracer::stop() {
+        enabled_.store(false, std::memory_order_release);
+    }
+
+    std::int64_t Tracer::now() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch_).count();
+    }
+
+    void Tracer::record(const char* name, std::int64_t start, std::int64_t end) {
+        ThreadBuffer& buffer = localBuffer();
+        unsigned long generation = generation_.load(std::memory_order_acquire);
+        if (buffer.generation.load(std::memory_order_relaxed) != generation) {
+            /** First event of this thread in a new trace: drop the old events and reserve the whole
+                capacity now, so that writeJson() never reads a vector that is being reallocated */
+            buffer.events.clear();
+            buffer.events.reserve(capacity_);
+            buffer.count.store(0, std::memory_order_relaxed);
+            buffer.dropped.store(0, std::memory_order_relaxed);
+            buffer.generation.store(generation, std::memory_order_release);
+        }
+        std::size_t n = buffer.count.load(std::memory_order_relaxed);
+        if (n >= capacity_) {
+            buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        buffer.events.push_back(Event{name, start, end - start});
+        buffer.count.store(n + 1, std::memory_order_release);
+    }
+
+    void Tracer::nameThread(const std::string& name) {
+        if (!enabled()) {
+            return; /** Untraced threads (e.g. every pool of every run) are not registered */
+        }
+        ThreadBuffer& buffer = localBuffer();
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        buffer.name = name;
+    }
+
+    std::size_t Tracer::dropped() {
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        unsigned long generation = generation_.load(std::memory_order_acquire);
+        std::size_t total = 0;
+        for (const auto& buffer : buffers_) {
+            if (buffer->generation.load(std::memory_order_acquire) == generation) {
+                total += buffer->dropped.load(std::memory_order_relaxed);
+            }
+        }
+        return total;
+    }
+
+    void Tracer::writeJson(std::ostream& os) {
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        unsigned long generation = generation_.load(std::memory_order_acquire);
+        std::size_t dropped = 0;
+
+        os << "{\"traceEvents\":[\n";
+        os << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"heat\"}}";
+        for (const auto& buffer : buffers_) {
+            if (!buffer->name.empty()) {
+                os << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->tid << ",\"args\":{\"name\":";
+                writeString(os, buffer->name.c_str());
+                os << "}}";
+            }
+            if (buffer->generation.load(std::memory_order_acquire) != generation) {
+                continue; /** Nothing recorded by this thread in the current trace */
+            }
+            std::size_t count = buffer->count.load(std::memory_order_acquire);
+            for (std::size_t k = 0; k < count; ++k) {
+                const Event& event = buffer->events[k];
+                os << ",\n{\"name\":";
+                writeString(os, event.name);
+                os << ",\"cat\":\"heat\",\"ph\":\"X\",\"ts\":";
+                writeMicroseconds(os, event.start);
+                os << ",\"dur\":";
+                writeMicroseconds(os, event.duration);
+                os << ",\"pid\":1,\"tid\":" << buffer->tid << "}";
+            }
+            dropped += buffer->dropped.load(std::memory_order_relaxed);
+        }
+        os << "\n],\n\"displayTimeUnit\":\"ms\",\n\"otherData\":{\"droppedEvents\":" << dropped << "}}\n";
+    }
+
+    void Tracer::writeJson(const std::string& path) {
+        std::ofstream file(path);
+        if (!file) {
+            throw std::runtime_error("Cannot open trace file " + path);
+        }
+        writeJson(file);
+        if (!file) {
+            throw std::runtime_error("Cannot write trace file " + path);
+        }
+    }
+
+}
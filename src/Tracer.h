@@ -0,0 +1,167 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace heat {
+
+    /**
+     * @brief Opt-in timeline of what each thread did, written as Chrome trace-event JSON.
+     *
+     * While started, every HEAT_TRACE_SCOPE records one complete event (name, start,
+     * duration) into a buffer owned by the calling thread: recording takes no lock and
+     * touches no shared cache line. Each buffer is capped at a set number of events;
+     * events past it are dropped and counted. When stopped, a scope costs one relaxed atomic load.
+     *
+     * The output opens in Perfetto (ui.perfetto.dev) or chrome://tracing.
+     */
+    class Tracer {
+    private:
+        /**
+         * @brief One timed scope.
+         */
+        struct Event {
+            const char* name;      /**< String literal naming the scope */
+            std::int64_t start;    /**< Nanoseconds since start() */
+            std::int64_t duration; /**< Nanoseconds */
+        };
+
+        /**
+         * @brief Events of one thread; only that thread writes to it.
+         */
+        struct ThreadBuffer {
+            int tid;                               /**< Thread id in the trace (registration order) */
+            std::string name;                      /**< Thread name shown in the timeline (may be empty) */
+            std::atomic<unsigned long> generation; /**< Trace the events belong to */
+            std::vector<Event> events;             /**< Reserved to the capacity when the thread joins a trace, so appending never moves it */
+            std::atomic<std::size_t> count;        /**< Events recorded (published with release) */
+            std::atomic<std::size_t> dropped;      /**< Events lost because the buffer was full */
+        };
+
+        std::atomic<bool> enabled_;                          /**< Scopes record only while set */
+        std::atomic<unsigned long> generation_;              /**< Incremented by start(): stale buffers are reset lazily */
+        std::size_t capacity_;                               /**< Events per thread buffer */
+        std::chrono::steady_clock::time_point epoch_;        /**< Time zero of the trace */
+        std::mutex registryMutex_;                           /**< Protects buffers_ (thread registration only) */
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers_; /**< One per thread that recorded or was named while tracing */
+
+        Tracer();
+
+        /**
+         * @brief Buffer of the calling thread, registered on first use.
+         */
+        ThreadBuffer& localBuffer();
+
+    public:
+        /**
+         * @brief The tracer every scope records into.
+         */
+        static Tracer& global();
+
+        Tracer(const Tracer&) = delete;
+        Tracer& operator=(const Tracer&) = delete;
+
+        /**
+         * @brief Starts a new trace, discarding the events of the previous one.
+         *
+         * @param eventsPerThread : Events kept per thread (reserved by each thread on its first event of the trace)
+         */
+        void start(std::size_t eventsPerThread = 1 << 16);
+
+        /**
+         * @brief Stops recording; the events stay available to writeJson().
+         */
+        void stop();
+
+        /**
+         * @brief Whether scopes are recording.
+         */
+        bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Nanoseconds since start().
+         */
+        std::int64_t now() const;
+
+        /**
+         * @brief Records a complete event on the calling thread.
+         *
+         * @param name : Event name; must outlive the tracer (use a string literal)
+         * @param start : Start time from now()
+         * @param end : End time from now()
+         */
+        void record(const char* name, std::int64_t start, std::int64_t end);
+
+        /**
+         * @brief Names the calling thread in the timeline; ignored while tracing is off.
+         *
+         * @param name : Thread name
+         */
+        void nameThread(const std::string& name);
+
+        /**
+         * @brief Events dropped by full buffers in the current trace.
+         */
+        std::size_t dropped();
+
+        /**
+         * @brief Writes the current trace in the Chrome trace-event format.
+         *
+         * Call once the traced threads are idle (e.g. after stop() and the runs are over).
+         *
+         * @param os : The output stream
+         */
+        void writeJson(std::ostream& os);
+
+        /**
+         * @brief Writes the trace to a file.
+         *
+         * @param path : Output file (.json)
+         * @throws std::runtime_error if the file cannot be written
+         */
+        void writeJson(const std::string& path);
+    };
+
+    /**
+     * @brief Records the enclosing block as one trace event if the tracer is on at entry.
+     *
+     * Use through HEAT_TRACE_SCOPE.
+     */
+    class TraceScope {
+    private:
+        const char* name_;   /**< Event name (string literal) */
+        std::int64_t start_; /**< Entry time, or -1 when not tracing */
+
+    public:
+        explicit TraceScope(const char* name)
+            : name_(name), start_(Tracer::global().enabled() ? Tracer::global().now() : -1) {}
+
+        ~TraceScope() {
+            if (start_ >= 0) {
+                Tracer& tracer = Tracer::global();
+                tracer.record(name_, start_, tracer.now());
+            }
+        }
+
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+    };
+
+}
+
+/**
+ * HEAT_TRACE_SCOPE("name") records the rest of the enclosing block as a trace event.
+ */
+#define HEAT_TRACE_CONCAT_(a, b) a##b
+#define HEAT_TRACE_CONCAT(a, b) HEAT_TRACE_CONCAT_(a, b)
+#define HEAT_TRACE_SCOPE(name) ::heat::TraceScope HEAT_TRACE_CONCAT(traceScope_, __LINE__)(name)
+
+#endif
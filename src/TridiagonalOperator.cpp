@@ -0,0 +1,79 @@
+#include "TridiagonalOperator.h"
+
+namespace heat {
+
+    void TridiagonalOperator::factor(const double* a, const double* b, const double* c, int size) {
+        size_ = size;
+        a_.assign(a, a + size - 1);
+        cStar_.resize(size - 1);
+        invPivot_.resize(size);
+
+        /** Forward elimination on the matrix only */
+        firstPivot_ = b[0];
+        invPivot_[0] = 1.0 / b[0];
+        double previousCStar = c[0] / b[0];
+        cStar_[0] = previousCStar;
+        for (int i = 1; i < size; ++i) {
+            double m = 1.0 / (b[i] - a[i - 1] * previousCStar);
+            invPivot_[i] = m;
+            if (i < size - 1) {
+                previousCStar = c[i] * m;
+                cStar_[i] = previousCStar;
+            }
+        }
+    }
+
+    void TridiagonalOperator::factor(double sub, double diag, double super, int size) {
+        std::vector<double> a(size - 1, sub), b(size, diag), c(size - 1, super);
+        factor(a.data(), b.data(), c.data(), size);
+    }
+
+    void TridiagonalOperator::apply(double* d) const {
+        const double* a = a_.data();
+        const double* cStar = cStar_.data();
+        const double* m = invPivot_.data();
+
+        /** Forward substitution (d is overwritten by d_star); the first row divides like the unfactored algorithm */
+        d[0] = d[0] / firstPivot_;
+        for (int i = 1; i < size_; ++i) {
+            d[i] = (d[i] - a[i - 1] * d[i - 1]) * m[i];
+        }
+
+        /** Back substitution */
+        for (int i = size_ - 2; i >= 0; --i) {
+            d[i] = d[i] - cStar[i] * d[i + 1];
+        }
+    }
+
+    void TridiagonalOperator::applyColumns(double* d, std::ptrdiff_t stride, int count) const {
+        const double* a = a_.data();
+        const double* cStar = cStar_.data();
+        const double* m = invPivot_.data();
+
+        /** Forward substitution, one row of all systems at a time */
+        double* row = d;
+        for (int k = 0; k < count; ++k) {
+            row[k] = row[k] / firstPivot_;
+        }
+        for (int i = 1; i < size_; ++i) {
+            double* __restrict current = d + i * stride;
+            const double* __restrict previous = current - stride;
+            double ai = a[i - 1];
+            double mi = m[i];
+            for (int k = 0; k < count; ++k) {
+                current[k] = (current[k] - ai * previous[k]) * mi;
+            }
+        }
+
+        /** Back substitution */
+        for (int i = size_ - 2; i >= 0; --i) {
+            double* __restrict current = d + i * stride;
+            const double* __restrict following = current + stride;
+            double ci = cStar[i];
+            for (int k = 0; k < count; ++k) {
+                current[k] = current[k] - ci * following[k];
+            }
+        }
+    }
+
+}
@@ -0,0 +1,90 @@
+#ifndef TRIDIAGONAL_OPERATOR_H
+#define TRIDIAGONAL_OPERATOR_H
+
+#include <cstddef>
+#include <vector>
+
+namespace heat {
+
+    /**
+     * @brief Tridiagonal matrix factored once (Thomas algorithm) and applied to many right-hand sides.
+     *
+     * The forward elimination only depends on the matrix, so the modified super-diagonal
+     * (c_star) and the reciprocal pivots are computed in factor(). Solving a system then
+     * reduces to a forward and a backward substitution without any division.
+     */
+    class TridiagonalOperator {
+    private:
+        int size_;                     /**< Size of the system */
+        double firstPivot_;            /**< Main diagonal value of the first row */
+        std::vector<double> a_;        /**< Sub-diagonal coefficients (size-1) */
+        std::vector<double> cStar_;    /**< Modified super-diagonal coefficients (size-1) */
+        std::vector<double> invPivot_; /**< Reciprocal pivots of the elimination (size) */
+
+    public:
+        /**
+         * @brief Creates an empty operator.
+         */
+        TridiagonalOperator() : size_(0), firstPivot_(1.0) {}
+
+        /**
+         * @brief Creates and factors an operator.
+         *
+         * @param a Sub-diagonal coefficients (size N-1)
+         * @param b Main diagonal coefficients (size N)
+         * @param c Super-diagonal coefficients (size N-1)
+         * @param size Size of the tridiagonal system
+         */
+        TridiagonalOperator(const double* a, const double* b, const double* c, int size) : TridiagonalOperator() {
+            factor(a, b, c, size);
+        }
+
+        /**
+         * @brief Factors a tridiagonal matrix, replacing any previous factorization.
+         *
+         * @param a Sub-diagonal coefficients (size N-1)
+         * @param b Main diagonal coefficients (size N)
+         * @param c Super-diagonal coefficients (size N-1)
+         * @param size Size of the tridiagonal system
+         */
+        void factor(const double* a, const double* b, const double* c, int size);
+
+        /**
+         * @brief Factors a matrix with constant coefficients on each diagonal.
+         *
+         * @param sub Sub-diagonal value
+         * @param diag Main diagonal value
+         * @param super Super-diagonal value
+         * @param size Size of the tridiagonal system
+         */
+        void factor(double sub, double diag, double super, int size);
+
+        /**
+         * @brief Solves the system in place by substitution only.
+         *
+         * @param d Right-hand side on input, solution on output (size N)
+         */
+        void apply(double* d) const;
+
+        /**
+         * @brief Solves several systems stored side by side, in place.
+         *
+         * Unknown i of system k is d[i * stride + k]. The innermost loop runs over the
+         * systems, so adjacent columns of a row-major grid are solved together in SIMD lanes
+         * with unit-stride accesses.
+         *
+         * @param d Right-hand sides on input, solutions on output
+         * @param stride Distance between two unknowns of the same system, in values
+         * @param count Number of systems (adjacent columns)
+         */
+        void applyColumns(double* d, std::ptrdiff_t stride, int count) const;
+
+        /**
+         * @brief Returns the size of the factored system.
+         */
+        int size() const { return size_; }
+    };
+
+}
+
+#endif
@@ -1,41 +1,36 @@
 #include "Visualization.h"
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 namespace heat{
-    // Initializes SDL and sets up the window and renderer
+    // Opens a private session: SDL, window and renderer
     void Visualization::initializeSDL() {
-        if (SDL_Init(SDL_INIT_VIDEO) != 0) {
-            std::cerr << "SDL_Init Error: " << SDL_GetError() << std::endl;
-            exit(1);
-        }
-        window = SDL_CreateWindow(windowTitle, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, windowWidth, windowHeight, SDL_WINDOW_SHOWN);
-        if (!window) {
-            std::cerr << "SDL_CreateWindow Error: " << SDL_GetError() << std::endl;
-            SDL_Quit();
-            exit(1);
-        }
-        renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
-        if (!renderer) {
-            std::cerr << "SDL_CreateRenderer Error: " << SDL_GetError() << std::endl;
-            SDL_DestroyWindow(window);
-            SDL_Quit();
-            exit(1);
-        }
+        // Errors are thrown (not exit) so that callers can fall back to a headless export
+        ownedSession.reset(new DisplaySession(windowTitle, windowWidth, windowHeight));
+        session = ownedSession.get();
+        renderer = session->renderer();
     }
 
     // Cleans up SDL resources
     void Visualization::cleanUp() {
-        if (renderer) SDL_DestroyRenderer(renderer);
-        if (window) SDL_DestroyWindow(window);
-        SDL_Quit();
+        ownedSession.reset();
+        session = nullptr;
+        renderer = nullptr;
     }
 
     // Constructor
     Visualization::Visualization(const char* title, int width, int height)
-        : windowTitle(title), window(nullptr), renderer(nullptr), windowWidth(width), windowHeight(height) {
+        : windowTitle(title), session(nullptr), renderer(nullptr), windowWidth(width), windowHeight(height), colormap(ColormapKind::GreenRed), playback(10.0), plotter(width, height), kymograph(0, 0, 0.0, 1.0, ColormapKind::GreenRed) {
         initializeSDL();
     }
 
+    // Constructor drawing in a shared session
+    Visualization::Visualization(DisplaySession& shared, const char* title, int width, int height)
+        : windowTitle(title), session(&shared), renderer(shared.renderer()), windowWidth(width), windowHeight(height), colormap(ColormapKind::GreenRed), playback(10.0), plotter(width, height), kymograph(0, 0, 0.0, 1.0, ColormapKind::GreenRed) {
+        session->beginScene(title, width, height);
+    }
+
     // Destructor
     Visualization::~Visualization() {
         cleanUp();
@@ -43,78 +38,113 @@ namespace heat{
 
     // Starts the SDL event loop
     void Visualization::startEventLoop() {
-        bool quit = false;
         SDL_Event e;
-        while (!quit) {
-            while (SDL_PollEvent(&e)) {
-                if (e.type == SDL_QUIT) quit = true;
-            }
+        while (SDL_WaitEvent(&e)) {
+            if (e.type == SDL_QUIT) break;
         }
     }
 
     // Renders a 2D temperature profile for a single time step
     void Visualization::render2DTemperatureProfile(const double* temperature, int size, double maxTemperature) {
+        // Build the whole curve as one vertex array (colors per vertex, decimated to the window width)
+        plotter.clear();
+        plotter.addProfile(temperature, size, 0.0, maxTemperature, colormap);
+
         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
         SDL_RenderClear(renderer);
+        plotter.draw(renderer);
+        session->present();
+    }
 
-        // Draw temperature profile lines
-        for (int i = 0; i < size - 1; ++i) {
-            SDL_Color color = getTemperatureColor(temperature[i], maxTemperature);
-            SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-
-            int x1 = (i * windowWidth) / size;
-            int x2 = ((i + 1) * windowWidth) / size;
-            int y1 = windowHeight - (int)((temperature[i] / maxTemperature) * windowHeight);
-            int y2 = windowHeight - (int)((temperature[i + 1] / maxTemperature) * windowHeight);
+    // Renders several profiles in distinct colors with one draw call
+    void Visualization::renderTemperatureProfileOverlay(const std::vector<const double*>& profiles, int size, double maxTemperature) {
+        static const Uint32 palette[] = {0xFFE6194B, 0xFF3CB44B, 0xFFFFE119, 0xFF4363D8, 0xFFF58231, 0xFF911EB4, 0xFF46F0F0, 0xFFF032E6};
+        const std::size_t paletteSize = sizeof(palette) / sizeof(palette[0]);
 
-            SDL_RenderDrawLine(renderer, x1, y1, x2, y2);
+        plotter.clear();
+        for (std::size_t k = 0; k < profiles.size(); ++k) {
+            plotter.addProfile(profiles[k], size, 0.0, maxTemperature, palette[k % paletteSize]);
         }
-        SDL_RenderPresent(renderer);
+
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+        SDL_RenderClear(renderer);
+        plotter.draw(renderer);
+        session->present();
     }
 
     // Renders multiple 2D temperature profiles over time
     void Visualization::renderMultiple2DTemperatureProfiles(const double** temperatureProfiles, int numTimeSteps, int spatialDivisions, double maxTemperature) {
-        for (int t = 0; t < numTimeSteps; ++t) {
+        playback.start(numTimeSteps);
+        for (int t = playback.nextFrame(); t >= 0; t = playback.nextFrame()) {
             render2DTemperatureProfile(temperatureProfiles[t], spatialDivisions, maxTemperature);
-            SDL_Delay(100); // Delay for smooth visualization
+        }
+    }
+
+    // Renders the rows of a field view over time
+    void Visualization::renderMultiple2DTemperatureProfiles(const FieldView& temperatureProfiles, double maxTemperature) {
+        playback.start(temperatureProfiles.rows());
+        for (int t = playback.nextFrame(); t >= 0; t = playback.nextFrame()) {
+            render2DTemperatureProfile(temperatureProfiles.row(t), temperatureProfiles.cols(), maxTemperature);
         }
     }
 
     void Visualization::render2DTemperatureProfile(const double* temperature, int rows, int cols, double maxTemperature) {
+        // Colorize every cell into an ARGB buffer in one pass through the lookup table
+        pixels.resize(static_cast<size_t>(rows) * cols);
+        colormap.colorize(temperature, rows * cols, 0.0, maxTemperature, pixels.data());
+
+        // One upload and one copy; the renderer scales the map to the window
         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
         SDL_RenderClear(renderer);
+        StreamingTexture& texture = session->texture(SceneTexture::Map);
+        if (texture.upload(renderer, cols, rows, pixels.data())) {
+            texture.draw(renderer);
+        }
+        session->present();
+    }
 
-        int cellWidth = windowWidth / cols;
-        int cellHeight = windowHeight / rows;
+    // Starts an empty space-time heatmap
+    void Visualization::beginKymograph(int size, int timeSteps, double minTemperature, double maxTemperature) {
+        kymograph.reset(size, timeSteps, minTemperature, maxTemperature);
+    }
 
-        for (int row = 0; row < rows; ++row) {
-            for (int col = 0; col < cols; ++col) {
-                double temp = temperature[row * cols + col];
-                SDL_Color color = getTemperatureColor(temp, maxTemperature);
-                SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+    // Colorizes one time step into its heatmap row
+    void Visualization::appendKymographRow(int timeStep, const double* temperature) {
+        kymograph.appendRow(timeStep, temperature);
+    }
 
-                SDL_Rect cellRect = { col * cellWidth, row * cellHeight, cellWidth, cellHeight };
-                SDL_RenderFillRect(renderer, &cellRect);
-            }
-        }
+    // Uploads the new rows and draws the heatmap
+    void Visualization::renderKymograph() {
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+        SDL_RenderClear(renderer);
+        kymograph.draw(renderer, session->texture(SceneTexture::Kymograph));
+        session->present();
+    }
 
-        SDL_RenderPresent(renderer);
+    // Draws a stored run as one heatmap
+    void Visualization::renderKymograph(const FieldView& temperatureProfiles, double minTemperature, double maxTemperature) {
+        kymograph.reset(temperatureProfiles.cols(), temperatureProfiles.rows(), minTemperature, maxTemperature);
+        kymograph.appendAll(temperatureProfiles);
+        renderKymograph();
     }
 
     // Calculates a color representation for a given temperature
     SDL_Color Visualization::getTemperatureColor(double temperature, double maxTemperature) {
-        // Normalize the temperature to [0, 1]
-        double normalizedTemp = temperature / maxTemperature;
-        if (normalizedTemp < 0.0) normalizedTemp = 0.0;
-        if (normalizedTemp > 1.0) normalizedTemp = 1.0;
+        // Normalize the temperature to [0, 1] and look it up in the color scale
+        Uint32 packed = colormap.color(temperature / maxTemperature);
 
         SDL_Color color;
-        color.r = (Uint8)(normalizedTemp * 255);
-        color.g = (Uint8)((1.0 - normalizedTemp) * 255);
-        color.b = 0;
-        color.a = 255;
+        color.r = (Uint8)(packed >> 16);
+        color.g = (Uint8)(packed >> 8);
+        color.b = (Uint8)packed;
+        color.a = (Uint8)(packed >> 24);
 
         return color;
     }
 
+    void Visualization::setColormap(ColormapKind kind) {
+        colormap = Colormap(kind);
+        kymograph.setColormap(kind);
+    }
+
 }
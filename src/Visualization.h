@@ -4,6 +4,14 @@
 
 #include <SDL2/SDL.h>
 #include <iostream>
+#include <memory>
+#include <vector>
+#include "Colormap.h"
+#include "DisplaySession.h"
+#include "FieldView.h"
+#include "Kymograph.h"
+#include "PlaybackController.h"
+#include "ProfilePlotter.h"
 
 namespace heat{
     /**
@@ -13,18 +21,24 @@ namespace heat{
 
     private:
         const char* windowTitle; /** Title of the SDL window */
-        SDL_Window* window; /** Pointer to the SDL window */
-        SDL_Renderer* renderer; /** Pointer to the SDL renderer */
+        std::unique_ptr<DisplaySession> ownedSession; /** Session opened by this object when none is shared */
+        DisplaySession* session; /** Window, renderer and textures in use */
+        SDL_Renderer* renderer; /** Pointer to the SDL renderer (owned by the session) */
         int windowWidth; /** Width of the SDL window */
         int windowHeight; /** Height of the SDL window */
+        std::vector<Uint32> pixels; /** Colorized 2D temperature map, reused between frames */
+        Colormap colormap; /** Temperature color scale (green to red by default) */
+        PlaybackController playback; /** Paces animations (10 frames per second by default) */
+        ProfilePlotter plotter; /** Vertex arrays of the 1D profile plots */
+        Kymograph kymograph; /** Space-time heatmap of the current run */
 
         /**
-         * @brief Initializes SDL and creates the window and renderer
+         * @brief Opens a private display session (SDL, window and renderer)
          */
         void initializeSDL();
 
         /**
-         * @brief Cleans up SDL resources
+         * @brief Closes the private display session, if any
          */
         void cleanUp();
         
@@ -39,29 +53,67 @@ namespace heat{
         Visualization(const char* title, int width = 1003, int height = 600);
 
         /**
-         * @brief cleans up SDL resources
+         * @brief a new Visualization object drawing in a shared display session
+         * 
+         * Starts a new scene in the session window; SDL is neither initialized nor shut down.
+         * 
+         * @param session The display session to draw in
+         * @param title The title of the window 
+         * @param width The width of the window
+         * @param height The height of the window
+         */
+        Visualization(DisplaySession& session, const char* title, int width = 1003, int height = 600);
+
+        /**
+         * @brief cleans up SDL resources (only those of a private session)
          */
         ~Visualization();
 
         /**
          * @brief Starts the SDL event loop for handling rendering and events
+         * 
+         * Sleeps in SDL_WaitEvent until the window is closed.
          */
         void startEventLoop();
 
         /**
          * @brief Renders a 2D temperature profile for a single time step
          * 
+         * The curve is drawn with one SDL_RenderGeometry call, colored per vertex and decimated
+         * to the window width.
+         * 
          * @param temperature : Array of temperature values
          * @param size : The number of spatial divisions (length of the array)
          * @param maxTemperature : The maximum temperature value for color scaling
          */
         void render2DTemperatureProfile(const double* temperature, int size, double maxTemperature);
 
+        /**
+         * @brief Renders several temperature profiles on top of each other in one pass
+         * 
+         * Each profile gets its own solid color, e.g. to compare time steps or materials.
+         * 
+         * @param profiles : The temperature profiles, all of the same length
+         * @param size : The number of spatial divisions (length of each profile)
+         * @param maxTemperature : The maximum temperature value for scaling
+         */
+        void renderTemperatureProfileOverlay(const std::vector<const double*>& profiles, int size, double maxTemperature);
+
+        /**
+         * @brief Renders a temperature map as one texture scaled to the window
+         * 
+         * @param temperature : Row-major array of rows * cols temperature values
+         * @param rows : Number of rows of the map
+         * @param cols : Number of columns of the map
+         * @param maxTemperature : The maximum temperature value for color scaling
+         */
         void render2DTemperatureProfile(const double* temperature, int rows, int cols, double maxTemperature);
 
         /**
          * @brief Renders multiple 2D temperature profiles over time
          * 
+         * Playback is paced by the playback controller; frames are skipped when drawing falls behind.
+         * 
          * @param temperatureProfiles : Array of temperature arrays for different time steps
          * @param numTimeSteps : The number of time steps
          * @param spatialDivisions : The number of spatial divisions in each temperature profile
@@ -69,6 +121,48 @@ namespace heat{
          */
         void renderMultiple2DTemperatureProfiles(const double** temperatureProfiles, int numTimeSteps, int spatialDivisions, double maxTemperature);
 
+        /**
+         * @brief Renders multiple 2D temperature profiles over time, one row of the view per time step
+         * 
+         * Playback is paced by the playback controller; frames are skipped when drawing falls behind.
+         * 
+         * @param temperatureProfiles : View of the temperature profiles (rows = time steps, cols = spatial divisions)
+         * @param maxTemperature : The maximum temperature value for color scaling
+         */
+        void renderMultiple2DTemperatureProfiles(const FieldView& temperatureProfiles, double maxTemperature);
+
+        /**
+         * @brief Starts an empty space-time heatmap (x horizontal, time going down)
+         * 
+         * @param size : The number of spatial divisions
+         * @param timeSteps : The number of time steps of the run
+         * @param minTemperature : The temperature mapped to the coldest color
+         * @param maxTemperature : The temperature mapped to the hottest color
+         */
+        void beginKymograph(int size, int timeSteps, double minTemperature, double maxTemperature);
+
+        /**
+         * @brief Adds the profile of one time step to the heatmap (shown by the next renderKymograph)
+         * 
+         * @param timeStep : The time step index
+         * @param temperature : The temperature profile
+         */
+        void appendKymographRow(int timeStep, const double* temperature);
+
+        /**
+         * @brief Draws the heatmap: one texture, only the rows appended since the last call are uploaded
+         */
+        void renderKymograph();
+
+        /**
+         * @brief Draws a whole stored run as one heatmap
+         * 
+         * @param temperatureProfiles : View of the temperature profiles (rows = time steps, cols = spatial divisions)
+         * @param minTemperature : The temperature mapped to the coldest color
+         * @param maxTemperature : The temperature mapped to the hottest color
+         */
+        void renderKymograph(const FieldView& temperatureProfiles, double minTemperature, double maxTemperature);
+
         /**
          * @brief Calculates a color representation for a given temperature
          * 
@@ -77,6 +171,18 @@ namespace heat{
          * @return SDL_Color The color representing the temperature
          */
         SDL_Color getTemperatureColor(double temperature, double maxTemperature);
+
+        /**
+         * @brief Selects the temperature color scale
+         * 
+         * @param kind : The color scale
+         */
+        void setColormap(ColormapKind kind);
+
+        /**
+         * @brief Gives access to the animation pacing (frame rate, speed, pause, seek)
+         */
+        PlaybackController& playbackController() { return playback; }
     };
 
 }
@@ -5,37 +5,30 @@
 namespace heat {
 
     Visualization2D::Visualization2D(int windowWidth, int windowHeight)
-        : windowWidth_(windowWidth), windowHeight_(windowHeight), window_(nullptr), renderer_(nullptr) {
-        if (SDL_Init(SDL_INIT_VIDEO) < 0) {
-            throw std::runtime_error("Failed to initialize SDL");
-        }
-
-        window_ = SDL_CreateWindow("2D Heat Equation Visualization2D", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, windowWidth_, windowHeight_, SDL_WINDOW_SHOWN);
-        if (!window_) {
-            throw std::runtime_error("Failed to create SDL window");
-        }
-
-        renderer_ = SDL_CreateRenderer(window_, -1, SDL_RENDERER_ACCELERATED);
-        if (!renderer_) {
-            throw std::runtime_error("Failed to create SDL renderer");
-        }
+        : windowWidth_(windowWidth), windowHeight_(windowHeight), session_(nullptr), renderer_(nullptr), minTemp_(0.0), maxTemp_(1.0), colormap_(ColormapKind::BlueRed), resampleMode_(ResampleMode::Box), playback_(30.0) {
+        ownedSession_.reset(new DisplaySession("2D Heat Equation Visualization2D", windowWidth_, windowHeight_));
+        session_ = ownedSession_.get();
+        renderer_ = session_->renderer();
     }
 
-
-    Visualization2D::~Visualization2D() {
-        SDL_DestroyRenderer(renderer_);
-        SDL_DestroyWindow(window_);
-        SDL_Quit();
+    Visualization2D::Visualization2D(DisplaySession& session, int windowWidth, int windowHeight)
+        : windowWidth_(windowWidth), windowHeight_(windowHeight), session_(&session), renderer_(session.renderer()), minTemp_(0.0), maxTemp_(1.0), colormap_(ColormapKind::BlueRed), resampleMode_(ResampleMode::Box), playback_(30.0) {
+        session_->beginScene("2D Heat Equation Visualization2D", windowWidth_, windowHeight_);
     }
 
-    void Visualization2D::computeTemperatureRange(const std::vector<std::vector<std::vector<double>>>& frames) {
+    Visualization2D::~Visualization2D() = default;
+
+    void Visualization2D::computeTemperatureRange(const FieldSequenceView& frames) {
         // Initialize minTemp_ and maxTemp_ with very large and very small values
         minTemp_ = 1e10;  // Arbitrarily large value for minTemp_
         maxTemp_ = -1e10; // Arbitrarily small value for maxTemp_
 
-        for (const auto& frame : frames) {
-            for (const auto& row : frame) {
-                for (double temp : row) {
+        for (int t = 0; t < frames.frames(); ++t) {
+            FieldView frame = frames.frame(t);
+            for (int i = 0; i < frame.rows(); ++i) {
+                const double* row = frame.row(i);
+                for (int j = 0; j < frame.cols(); ++j) {
+                    double temp = row[j];
                     // Update minTemp_ and maxTemp_
                     if (temp < minTemp_) minTemp_ = temp;
                     if (temp > maxTemp_) maxTemp_ = temp;
@@ -44,49 +37,56 @@ namespace heat {
         }
     }
 
-    void Visualization2D::showFrame(const std::vector<std::vector<double>>& frame) {
-        bool running = true;
-        SDL_Event event;
-
-        while (running) {
-            // Poll SDL events
-            while (SDL_PollEvent(&event)) {
-                if (event.type == SDL_QUIT) {
-                    running = false;
-                    break;
-                }
-            }
+    void Visualization2D::setTemperatureRange(double minTemperature, double maxTemperature) {
+        minTemp_ = minTemperature;
+        maxTemp_ = maxTemperature;
+    }
 
-            // Render the frame
-            SDL_SetRenderDrawColor(renderer_, 0, 0, 0, 255);
-            SDL_RenderClear(renderer_);
+    void Visualization2D::setTemperatureRange(const FrameStats& stats) {
+        if (stats.count > 0) {
+            setTemperatureRange(stats.min, stats.max);
+        }
+    }
 
-            // Map temperatures to colors and render the frame
-            for (size_t i = 0; i < frame.size(); ++i) {
-                for (size_t j = 0; j < frame[i].size(); ++j) {
-                    double normalizedTemp = (frame[i][j] - minTemp_) / (maxTemp_ - minTemp_);
-                    uint8_t colorValue = static_cast<uint8_t>(normalizedTemp * 255);
-                    SDL_SetRenderDrawColor(renderer_, colorValue, 0, 255 - colorValue, 255);
+    void Visualization2D::showFrame(const FieldView& frame) {
+        // Input is handled by the playback controller between frames
 
-                    SDL_Rect pixel = {static_cast<int>(j), static_cast<int>(i), 1, 1};
-                    SDL_RenderFillRect(renderer_, &pixel);
-                }
-            }
+        // Reduce the frame to at most one cell per window pixel
+        FieldView shown = frame;
+        if (frame.rows() > windowHeight_ || frame.cols() > windowWidth_) {
+            shown = resampler_.resample(frame, windowHeight_, windowWidth_, resampleMode_);
+        }
 
-            SDL_RenderPresent(renderer_);
+        // Map temperatures to colors in an ARGB buffer (row i, column j -> pixel (j, i))
+        pixels_.resize(static_cast<size_t>(shown.rows()) * shown.cols());
+        colormap_.colorize(shown, minTemp_, maxTemp_, pixels_.data());
 
-            // SDL_Delay(5); 
-            running = false; 
+        // Upload the frame once and let the renderer scale it to the window
+        SDL_SetRenderDrawColor(renderer_, 0, 0, 0, 255);
+        SDL_RenderClear(renderer_);
+        StreamingTexture& texture = session_->texture(SceneTexture::Frame);
+        if (texture.upload(renderer_, shown.cols(), shown.rows(), pixels_.data())) {
+            texture.draw(renderer_);
         }
+        session_->present();
     }
 
-    void Visualization2D::showAllFrames(const std::vector<std::vector<std::vector<double>>>& frames, int timestep) {
+    void Visualization2D::showAllFrames(const FieldSequenceView& frames, int timestep) {
         computeTemperatureRange(frames); 
 
-        for (int i = 0; i < timestep; i ++) {
+        playback_.start(timestep);
+        for (int i = playback_.nextFrame(); i >= 0; i = playback_.nextFrame()) {
             std::cout << "Timestep " << i + 1 << " of " << timestep << std::endl;
-            showFrame(frames[i]);
+            showFrame(frames.frame(i));
         }
     }
 
+    void Visualization2D::setResampleMode(ResampleMode mode) {
+        resampleMode_ = mode;
+    }
+
+    void Visualization2D::setColormap(ColormapKind kind) {
+        colormap_ = Colormap(kind);
+    }
+
 }
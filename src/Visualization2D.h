@@ -1,8 +1,15 @@
 #ifndef Visualization2D_H
 #define Visualization2D_H
 
+#include <memory>
 #include <vector>
 #include <SDL2/SDL.h>
+#include "Colormap.h"
+#include "DisplaySession.h"
+#include "FieldResampler.h"
+#include "FieldView.h"
+#include "FrameStats.h"
+#include "PlaybackController.h"
 
 namespace heat {
 
@@ -13,10 +20,16 @@ namespace heat {
     private:
         int windowWidth_;        /**< Width of the SDL window */
         int windowHeight_;       /**< Height of the SDL window */
-        SDL_Window* window_;     /**< SDL window pointer */
-        SDL_Renderer* renderer_; /**< SDL renderer pointer */
-        double minTemp_;
-        double maxTemp_;
+        std::unique_ptr<DisplaySession> ownedSession_; /**< Session opened by this object when none is shared */
+        DisplaySession* session_; /**< Window, renderer and textures in use */
+        SDL_Renderer* renderer_; /**< SDL renderer pointer (owned by the session) */
+        double minTemp_;         /**< Temperature mapped to the coldest color */
+        double maxTemp_;         /**< Temperature mapped to the hottest color */
+        std::vector<Uint32> pixels_; /**< Colorized frame, reused between frames */
+        Colormap colormap_;      /**< Temperature color scale (blue to red by default) */
+        FieldResampler resampler_; /**< Reduces frames larger than the window */
+        ResampleMode resampleMode_; /**< How cells are combined when a frame is reduced */
+        PlaybackController playback_; /**< Paces animations (30 frames per second by default) */
 
     public:
         /**
@@ -28,34 +41,89 @@ namespace heat {
         Visualization2D(int windowWidth = 503, int windowHeight = 503);
 
         /**
-         * @brief Destructor to deallocate resources used by SDL.
+         * @brief Constructor drawing in a shared display session.
+         * 
+         * Starts a new scene in the session window; SDL is neither initialized nor shut down.
+         * 
+         * @param session The display session to draw in
+         * @param windowWidth Width of the SDL window
+         * @param windowHeight Height of the SDL window
+         */
+        Visualization2D(DisplaySession& session, int windowWidth = 503, int windowHeight = 503);
+
+        /**
+         * @brief Destructor to deallocate resources used by SDL (only those of a private session).
          */
         ~Visualization2D();
 
         /**
          * @brief Compute minimum and maximum temperature for normalization color of temperature step
          * 
-         * @param frames A 3D vector containing multiple 2D grids representing temperature values at different timesteps. 
+         * @param frames A view of multiple 2D grids representing temperature values at different timesteps. 
          *               Each grid corresponds to a frame.
          */
-        void computeTemperatureRange(const std::vector<std::vector<std::vector<double>>>& frames);
+        void computeTemperatureRange(const FieldSequenceView& frames);
+
+        /**
+         * @brief Sets the temperatures mapped to the ends of the color scale
+         * 
+         * Used when frames are shown while they are being computed and cannot be pre-scanned.
+         * 
+         * @param minTemperature Temperature mapped to the coldest color
+         * @param maxTemperature Temperature mapped to the hottest color
+         */
+        void setTemperatureRange(double minTemperature, double maxTemperature);
+
+        /**
+         * @brief Sets the color scale to the extremes recorded by the solver
+         * 
+         * Replaces computeTemperatureRange() when the solver statistics are available: no pass over the frames is needed.
+         * 
+         * @param stats Statistics of one frame, or of several frames merged
+         */
+        void setTemperatureRange(const FrameStats& stats);
 
         /**
          * @brief Displays a single temperature frame.
          * 
-         * @param frame A 2D vector representing the temperature grid at a specific timestep. 
+         * Frames larger than the window are first reduced to the window size, so the cost of
+         * colorizing and uploading depends on the window and not on the grid. The result is
+         * colorized into an ARGB buffer, uploaded as one texture and scaled to the window.
+         * 
+         * @param frame A view of the temperature grid at a specific timestep. 
          *              Each element corresponds to a temperature value at a specific (x, y) position in the grid.
          */
-        void showFrame(const std::vector<std::vector<double>>& frame);
+        void showFrame(const FieldView& frame);
 
         /**
          * @brief Displays a sequence of temperature frames over time.
          * 
-         * @param frames A 3D vector containing multiple 2D grids representing temperature values at different timesteps. 
+         * Playback is paced by the playback controller; frames are skipped when drawing falls behind.
+         * 
+         * @param frames A view of multiple 2D grids representing temperature values at different timesteps. 
          *               Each grid corresponds to a frame.
          * @param timestep The total number of timesteps in the simulation (M).
          */
-        void showAllFrames(const std::vector<std::vector<std::vector<double>>>& frames, int timestep);
+        void showAllFrames(const FieldSequenceView& frames, int timestep);
+
+        /**
+         * @brief Selects how cells are combined when a frame is larger than the window.
+         * 
+         * @param mode Box average (default), or max/min pooling to keep hot/cold spots visible
+         */
+        void setResampleMode(ResampleMode mode);
+
+        /**
+         * @brief Selects the temperature color scale.
+         * 
+         * @param kind The color scale
+         */
+        void setColormap(ColormapKind kind);
+
+        /**
+         * @brief Gives access to the animation pacing (frame rate, speed, pause, seek).
+         */
+        PlaybackController& playbackController() { return playback_; }
 
         /**
          * @brief Clears the window and renderer.
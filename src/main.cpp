@@ -1,13 +1,182 @@
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
 #include <vector>
+#include "DisplaySession.h"
+#include "FrameExporter.h"
 #include "Material.h"
+#include "Metrics.h"
 #include "Result1D.h"
 #include "Result2D.h"
+#include "SweepScheduler.h"
+#include "Tracer.h"
+#include "Visualization.h"
+#include "Visualization2D.h"
+
+// Writes a sweep result to the same files as the serial headless runs: <material>_1D and <material>_2D
+static void exportSweepResult(const heat::SweepResult& result, heat::ExportFormat format) {
+    const heat::SweepJob& job = result.job;
+    std::string prefix = std::string(job.material.name) + (job.dimension == 1 ? "_1D" : "_2D");
+    if (job.dimension == 1) {
+        // One space-time image of the kept profiles, oldest at the top
+        std::vector<double> profiles(static_cast<std::size_t>(result.frames.size()) * job.N);
+        for (int k = 0; k < result.frames.size(); ++k) {
+            const double* profile = result.frames.frame(k).row(0);
+            std::copy(profile, profile + job.N, profiles.begin() + static_cast<std::size_t>(k) * job.N);
+        }
+        heat::FrameExporter exporter(prefix, format, heat::ColormapKind::GreenRed, result.stats.low, result.stats.high, 1);
+        exporter.submit(heat::FieldView(profiles.data(), result.frames.size(), job.N));
+        exporter.finish();
+    } else {
+        heat::FrameExporter exporter(prefix, format, heat::ColormapKind::BlueRed, result.stats.low, result.stats.high);
+        for (int k = 0; k < result.frames.size(); ++k) {
+            exporter.submit(result.frames.frame(k));
+        }
+        exporter.finish();
+    }
+}
+
+// Runs every simulation at once on all cores, then shows (or exports) the collected results one after another
+static void runSweep(const std::vector<heat::Material>& materials, double t_max, double L, double u0,
+                     int N_1D, int N_2D, int M, double f, heat::DisplaySession* display,
+                     bool headless, heat::ExportFormat exportFormat) {
+    heat::SweepScheduler sweep;
+    for (const auto& material : materials) {
+        sweep.addJob(heat::SweepJob(material, 1, N_1D, M, f, t_max, L, u0));
+    }
+    for (const auto& material : materials) {
+        heat::SweepJob job(material, 2, N_2D, M, f, t_max, L, u0);
+        job.snapshots = heat::SnapshotPolicy::every(5);  // Keep 21 frames per plate instead of 100
+        sweep.addJob(job);
+    }
+    sweep.run();
+
+    for (const auto& result : sweep.results()) {
+        std::cout << result.job.material.name << " (" << result.job.dimension << "D): ";
+        if (!result.completed) {
+            std::cout << "failed: " << result.error << "\n";
+            continue;
+        }
+        std::cout << result.seconds << " s, max " << result.stats.max << " K\n";
+        if (headless) {
+            exportSweepResult(result, exportFormat);
+            continue;
+        }
+        if (!display) {
+            continue;
+        }
+        if (result.job.dimension == 1) {
+            // Show the run as one space-time heatmap; each kept profile goes to the row of its time step
+            heat::Visualization visualizer(*display, "1D Heat Equation Visualization");
+            visualizer.beginKymograph(result.job.N, result.job.M, result.stats.low, result.stats.high);
+            for (int k = 0; k < result.frames.size(); ++k) {
+                visualizer.appendKymographRow(result.frames.timeStep(k), result.frames.frame(k).row(0));
+            }
+            visualizer.renderKymograph();
+            visualizer.playbackController().idle(2000);
+        } else {
+            heat::Visualization2D visualizer(*display);
+            visualizer.setTemperatureRange(result.stats);
+            heat::PlaybackController& playback = visualizer.playbackController();
+            playback.start(result.frames.size());
+            for (int k = playback.nextFrame(); k >= 0; k = playback.nextFrame()) {
+                visualizer.showFrame(result.frames.frame(k));
+            }
+        }
+    }
+}
+
+// Writes the hot-path timers gathered during the run (all zero unless built with -DHEAT_ENABLE_METRICS)
+static void writeMetrics(const std::string& path) {
+    if (path.empty()) {
+        return;
+    }
+    if (!heat::Metrics::enabled) {
+        std::cerr << "Metrics are compiled out: rebuild with -DHEAT_ENABLE_METRICS to fill " << path << "\n";
+    }
+    heat::Metrics::global().writeJson(path);
+}
+
+// Shows the runs one after another, each while the next one solves in the background: run 0 is solved
+// and drawn live by runSimulation(), every later run k is started by launch(k) while run k - 1 is on
+// screen and displayed by show(k, handle)
+template <class Result, class Launch, class Show>
+static void showWhileSolvingNext(std::vector<Result>& runs, const std::vector<heat::Material>& materials,
+                                 Launch launch, Show show) {
+    decltype(launch(std::size_t(0))) next;
+    for (std::size_t k = 0; k < runs.size(); ++k) {
+        auto current = next;
+        if (k + 1 < runs.size()) {
+            next = launch(k + 1);
+        }
+        std::cout << "Simulating for material: " << materials[k].name << "\n";
+        try {
+            if (k == 0) {
+                runs[k].runSimulation();
+            } else {
+                show(k, current);
+            }
+        } catch (...) {
+            if (k + 1 < runs.size()) {
+                next.cancel();  // Do not keep solving a run that will never be shown
+            }
+            throw;
+        }
+    }
+}
+
+// Stops the tracer and writes the timeline of the run (open it in Perfetto)
+static void writeTrace(const std::string& path) {
+    if (path.empty()) {
+        return;
+    }
+    heat::Tracer& tracer = heat::Tracer::global();
+    tracer.stop();
+    if (tracer.dropped() > 0) {
+        std::cerr << tracer.dropped() << " trace events did not fit in the thread buffers\n";
+    }
+    tracer.writeJson(path);
+}
 
 int SDL_main(int argc, char* argv[]){
-    (void)argc; 
-    (void)argv; 
     try{
+        // "--export ppm|png|y4m" writes the animations to files instead of opening windows
+        // "--sweep" solves all the simulations concurrently before showing them
+        // "--metrics file.json" dumps the per-phase timers at the end of the run
+        // "--trace file.json" records a per-thread timeline of the solvers and the renderer
+        bool headless = false;
+        bool sweep = false;
+        std::string metricsPath;
+        std::string tracePath;
+        heat::ExportFormat exportFormat = heat::ExportFormat::PNG;
+        for (int i = 1; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--sweep") == 0) {
+                sweep = true;
+            } else if (std::strcmp(argv[i], "--metrics") == 0 && i + 1 < argc) {
+                metricsPath = argv[++i];
+            } else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+                tracePath = argv[++i];
+            } else if (std::strcmp(argv[i], "--export") == 0 && i + 1 < argc) {
+                headless = true;
+                ++i;
+                if (std::strcmp(argv[i], "ppm") == 0) exportFormat = heat::ExportFormat::PPM;
+                else if (std::strcmp(argv[i], "png") == 0) exportFormat = heat::ExportFormat::PNG;
+                else if (std::strcmp(argv[i], "y4m") == 0) exportFormat = heat::ExportFormat::Y4M;
+                else {
+                    std::cerr << "Error: unknown export format '" << argv[i] << "' (expected png, ppm or y4m)" << std::endl;
+                    return 1;
+                }
+            }
+        }
+
+        if (!tracePath.empty()) {
+            heat::Tracer::global().start();
+            heat::Tracer::global().nameThread("main");
+        }
+
         // Materials from Table 2
         std::vector<heat::Material> materials = {
             heat::copper, 
@@ -22,32 +191,87 @@ int SDL_main(int argc, char* argv[]){
         double u0 = 286.15;    // Initial temperature in Kelvin
         int N_1D = 1001;        // Number of spatial points 
         int N_2D = 501;     // Number of spatial points (501 for x and 501 for y) 
-                            // It does not fit the window height if we use 1001 for x and y, so we use 501 each
+                            // The window shows any size, but 1001 each would make every step four times slower
+                            // to solve and every kept frame four times larger (8 MB), so we use 501 each
         int M = 100;        // Number of time steps
         double f = 1353.15;     // Heat source intensity factor in Kelvin
 
-        // (1D) Iterate through each material and solve the heat equation 
-        for (const auto& material : materials) {
-            std::cout << "Simulating for material: " << material.name << "\n";
-
-            // Set up the simulation for the current material
-            heat::Result1D simulation1D(f, t_max, L, u0, N_1D, M, material);
+        // One window for every run: SDL is initialized once and each run starts a new scene in it
+        std::unique_ptr<heat::DisplaySession> display;
+        if (!headless) {
+            display.reset(new heat::DisplaySession("Heat Equation", 1003, 600));
+        }
 
-            // Run the simulation
-            simulation1D.runSimulation();
+        if (sweep) {
+            runSweep(materials, t_max, L, u0, N_1D, N_2D, M, f, display.get(), headless, exportFormat);
+            writeMetrics(metricsPath);
+            writeTrace(tracePath);
+            return 0;
         }
 
-        // (2D) Iterate through each material and solve the heat equation 
-        for (const auto& material : materials) {
-            std::cout << "Simulating for material: " << material.name << "\n";
+        if (headless) {
+            // (1D) Iterate through each material and stream the evolution to files
+            for (const auto& material : materials) {
+                std::cout << "Simulating for material: " << material.name << "\n";
+                heat::Result1D simulation1D(f, t_max, L, u0, N_1D, M, material);
+                simulation1D.setHeadlessExport(std::string(material.name) + "_1D", exportFormat);
+                simulation1D.runSimulation();
+            }
 
-            // Set up the simulation for the current material
-            heat::Result2D simulation2D(f, t_max, L, u0, N_2D, M, material);
+            // (2D) Iterate through each material and stream the frames to files
+            for (const auto& material : materials) {
+                std::cout << "Simulating for material: " << material.name << "\n";
+                heat::Result2D simulation2D(f, t_max, L, u0, N_2D, M, material);
+                simulation2D.setHeadlessExport(std::string(material.name) + "_2D", exportFormat);
+                simulation2D.runSimulation();
+            }
+        } else {
+            // (1D) The first rod is drawn live as it solves; each later rod solves in the background
+            // while the previous one is shown, keeping every profile in a ring (800 kB per rod)
+            heat::SnapshotPolicy profiles1D = heat::SnapshotPolicy::every(1);
+            std::vector<heat::Result1D> runs1D;
+            for (const auto& material : materials) {
+                runs1D.emplace_back(f, t_max, L, u0, N_1D, M, material);
+                runs1D.back().setDisplaySession(display.get());
+            }
+            std::vector<std::unique_ptr<heat::FrameRing>> rings1D(materials.size());
+            showWhileSolvingNext(runs1D, materials,
+                [&](std::size_t k) {
+                    rings1D[k].reset(new heat::FrameRing(profiles1D.selectedCount(M - 1), 1, N_1D));
+                    return runs1D[k].solveAsync(profiles1D, rings1D[k]->rowSink());
+                },
+                [&](std::size_t k, const heat::RunHandle<heat::HeatEquationSolver1D>& run) {
+                    runs1D[k].showResult(*run.get(), *rings1D[k]);
+                    rings1D[k].reset();
+                });
 
-            // Run the simulation
-            simulation2D.runSimulation();
+            // (2D) Same for the plates; the background runs keep every 5th step and the last in a ring
+            // (21 of 100 frames) so that a run in flight needs about 40 MB instead of 200 MB
+            // Run 1 solves next to the live solve of run 0, so these two share the cores; later runs
+            // only overlap with drawing and use them all
+            heat::SnapshotPolicy frames2D = heat::SnapshotPolicy::every(5);
+            int halfCores = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) / 2);
+            std::vector<heat::Result2D> runs2D;
+            for (const auto& material : materials) {
+                runs2D.emplace_back(f, t_max, L, u0, N_2D, M, material);
+                runs2D.back().setDisplaySession(display.get());
+                runs2D.back().setThreadCount(runs2D.size() <= 2 ? halfCores : 0);
+            }
+            std::vector<std::unique_ptr<heat::FrameRing>> rings2D(materials.size());
+            showWhileSolvingNext(runs2D, materials,
+                [&](std::size_t k) {
+                    rings2D[k].reset(new heat::FrameRing(frames2D.selectedCount(M - 1), N_2D, N_2D));
+                    return runs2D[k].solveAsync(frames2D, rings2D[k]->sink());
+                },
+                [&](std::size_t k, const heat::RunHandle<heat::HeatEquationSolver2D>& run) {
+                    runs2D[k].showResult(*run.get(), *rings2D[k]);
+                    rings2D[k].reset();
+                });
         }
 
+        writeMetrics(metricsPath);
+        writeTrace(tracePath);
+
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
     }